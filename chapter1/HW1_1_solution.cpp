@@ -1,6 +1,13 @@
-#include <iostream>
 #include <cstddef>
 
+#ifdef LEAN_OUTPUT
+#include "lean_out.h"   // io::cout without <iostream> (lean build, see CMakeLists.txt)
+namespace io = lean;
+#else
+#include <iostream>
+namespace io = std;
+#endif
+
 /*
 HW1.1: Justify the situation with volatile nullptr_t using the standard
 
@@ -21,6 +28,10 @@ Standard references:
 - [conv.ptr] 4.10 Pointer conversions
 - [basic.compound] 3.9.2 Compound types
 - [type.nullptr] 2.14.7 Pointer literals
+
+Note: volatile fits memory-mapped I/O and signal handlers, NOT flags shared
+between threads - volatile orders nothing and such a flag is a data race.
+Use the std::atomic primitives in signal_flag.h for that.
 */
 
 int main() {
@@ -29,13 +40,13 @@ int main() {
     int *b;
     b = a;  // Valid: implicit conversion from nullptr_t to int*
     
-    std::cout << "b is " << (b == nullptr ? "nullptr" : "not nullptr") << std::endl;
+    io::cout << "b is " << (b == nullptr ? "nullptr" : "not nullptr") << io::endl;
     
     // Demonstrate the same with const volatile
     const volatile std::nullptr_t c = nullptr;
     double *d = c;  // Also valid
     
-    std::cout << "d is " << (d == nullptr ? "nullptr" : "not nullptr") << std::endl;
+    io::cout << "d is " << (d == nullptr ? "nullptr" : "not nullptr") << io::endl;
     
     return 0;
 }
@@ -52,24 +63,24 @@ C++ volatile nullptr_t Conversion Demo
 main() function entry
 1a
 Declare volatile nullptr_t
-HW1_1_solution.cpp:28
+HW1_1_solution.cpp:39
 volatile std::nullptr_t a = nullptr;
 Declare int pointer variable
 1c
 Implicit conversion assignment
-HW1_1_solution.cpp:30
+HW1_1_solution.cpp:41
 b = a;  // Valid: implicit conversion from nullptr_t to int*
 1d
 Verify conversion result
-HW1_1_solution.cpp:32
-std::cout << "b is " << (b == nullptr ? "nullptr" : "not nullptr") << std::endl;
+HW1_1_solution.cpp:43
+io::cout << "b is " << (b == nullptr ? "nullptr" : "not nullptr") << io::endl;
 1e
 Declare const volatile nullptr_t
-HW1_1_solution.cpp:35
+HW1_1_solution.cpp:46
 const volatile std::nullptr_t c = nullptr;
 1f
 Convert to double pointer
-HW1_1_solution.cpp:36
+HW1_1_solution.cpp:47
 double *d = c;  // Also valid
 Output verification for double ptr
 */
\ No newline at end of file
@@ -1,6 +1,9 @@
 #include <iostream>
 #include <typeinfo>
 #include <string>
+#include <type_traits>
+
+#include "type_name.h"   // typeName<T>(): compile-time names; demangledName(): cached demangling
 
 /*
 HW1.2: Find another elegant example where dereferencing a null pointer is valid
@@ -16,13 +19,17 @@ struct TestClass {
     int data = 42;
 };
 
+// typeName is evaluated by the compiler - no RTTI involved
+static_assert(typeName<decltype(TestClass::data)>() == "int", "typeName<T>() must be constexpr");
+
 int main() {
     // Example 1: Using decltype with dereferenced null pointer
     TestClass* ptr = nullptr;
     
     // This is valid - decltype doesn't evaluate the expression
     decltype((*ptr).data) var = 100;  // var is of type int
-    std::cout << "Type of var: " << typeid(var).name() << ", value: " << var << std::endl;
+    std::cout << "Type of var: " << typeName<decltype(var)>() << " (typeid: " << typeid(var).name()
+              << "), value: " << var << std::endl;
     
     // Example 2: Using sizeof with dereferenced null pointer
     size_t size = sizeof((*ptr).data);  // Valid - sizeof doesn't evaluate
@@ -33,8 +40,13 @@ int main() {
     std::cout << "Member function is noexcept: " << std::boolalpha << is_noexcept << std::endl;
     
     // Example 4: Using typeid with member access
-    const std::type_info& info = typeid((*ptr).memberFunction);
-    std::cout << "Type info for member function: " << info.name() << std::endl;
+    // A bound member function `(*ptr).memberFunction` is not an expression
+    // typeid accepts; the member function POINTER has a type it can name
+    const std::type_info& info = typeid(&std::remove_pointer_t<decltype(ptr)>::memberFunction);
+    std::cout << "Type info for member function: " << info.name() << " = " << demangledName(info) << std::endl;
+    
+    // Example 5: The static type of the call, spelled at compile time
+    std::cout << "Type of (*ptr).memberFunction(): " << typeName<decltype((*ptr).memberFunction())>() << std::endl;
     
     return 0;
 }
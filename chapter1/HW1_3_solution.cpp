@@ -1,6 +1,20 @@
 #include <iostream>
-#include <stdexcept>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __has_include(<expected>)
+#include <expected>
+#endif
 
 /*
 HW1.3: Find how to write proper protection code for the function
@@ -11,11 +25,29 @@ Multiple approaches for protection:
 2. Exception-based protection
 3. Optional return type
 4. Reference parameter with bounds checking
+5. std::expected with a descriptive error (C++23)
+
+Every approach also has a fixed-size overload (the size comes from T[N] or
+std::array) and approaches 2-4 have batch variants for millions of lookups.
+
+The benchmarks reuse these solutions: they define HW1_3_NO_MAIN and
+#include "../HW1_3_solution.cpp".
 */
 
+#include "arena.h"       // MonotonicArena: storage for SafeArray::fromArena
+#include "safe_gather.h" // Branch-free scalar/SSE2/AVX2 kernels behind the batch variants
+
+// Why an access failed, with the offending index and the array size
+struct AccessError {
+    enum class Kind { NullPointer, OutOfBounds };
+
+    Kind kind;
+    long long index;
+    std::size_t size;
+};
+
 // Approach 1: Assert-based protection
-#include <cassert>
-int foo_assert(int *a, int base, int off, size_t size) {
+int foo_assert(int *a, int base, int off, [[maybe_unused]] size_t size) {   // Unused with -DNDEBUG
     assert(a != nullptr && "Pointer cannot be null");
     assert(base + off >= 0 && static_cast<size_t>(base + off) < size && "Index out of bounds");
     return a[base + off];
@@ -34,7 +66,6 @@ int foo_exception(int *a, int base, int off, size_t size) {
 }
 
 // Approach 3: Optional return type (C++17)
-#include <optional>
 std::optional<int> foo_optional(int *a, int base, int off, size_t size) {
     if (a == nullptr || base + off < 0 || static_cast<size_t>(base + off) >= size) {
         return std::nullopt;
@@ -42,38 +73,454 @@ std::optional<int> foo_optional(int *a, int base, int off, size_t size) {
     return a[base + off];
 }
 
-// Approach 4: Safe wrapper with bounds checking
-struct SafeArray {
-    int* data;
-    size_t size;
-    
-    int get(int base, int off) const {
-        if (data == nullptr) {
+/*
+===============================================================================
+Approach 4: Safe wrapper with bounds checking
+SafeArray<T, CheckPolicy, Extent> - one wrapper, several ways to react to a
+bad index
+===============================================================================
+
+PROBLEMS WITH THE ORIGINAL struct SafeArray:
+- int index = base + off;   can overflow (undefined behaviour) BEFORE the check
+- Every get() pays for a throw-capable branch, even where the caller has
+  already proven the index is fine
+
+POLICIES (what get() returns and does on failure):
+- ThrowOnError     : T, throws std::runtime_error / std::out_of_range (original)
+- OptionalOnError  : std::optional<T>, std::nullopt on failure
+- ExpectedOnError  : std::expected<T, AccessError> (when the library has it)
+- AssertOnError    : T, assert() in debug builds, NO check with -DNDEBUG
+- Unchecked        : T, never checks - same code as a[base + off]
+
+OVERFLOW-SAFE INDEX:
+- base + off is computed in long long, which cannot overflow for two ints,
+  and validated with one unsigned compare: (unsigned long long)index < size
+
+ARENA STORAGE:
+- SafeArray<T>::fromArena(arena, n) takes its storage from a MonotonicArena
+  (arena.h) instead of borrowing a caller-managed pointer
+
+COMPILE-TIME BOUNDS:
+- With a static Extent (built from T[N] or std::array<T, N>) the size is a
+  constant: at<Base, Off>() is rejected by static_assert when out of bounds
+  and compiles to a plain load; get() with constant arguments folds away
+- Everything is constexpr, so checks also run during constant evaluation
+===============================================================================
+*/
+
+struct ThrowOnError {
+    static constexpr bool checks = true;
+    template <typename T> using Result = T;
+
+    template <typename T>
+    static constexpr T ok(const T& value) { return value; }
+
+    template <typename T>
+    static T fail(const AccessError& error) {
+        if (error.kind == AccessError::Kind::NullPointer) {
+            throw std::runtime_error("Array data is null");
+        }
+        throw std::out_of_range("Index out of bounds");
+    }
+};
+
+struct OptionalOnError {
+    static constexpr bool checks = true;
+    template <typename T> using Result = std::optional<T>;
+
+    template <typename T>
+    static constexpr std::optional<T> ok(const T& value) { return value; }
+
+    template <typename T>
+    static constexpr std::optional<T> fail(const AccessError&) { return std::nullopt; }
+};
+
+#if defined(__cpp_lib_expected)
+struct ExpectedOnError {
+    static constexpr bool checks = true;
+    template <typename T> using Result = std::expected<T, AccessError>;
+
+    template <typename T>
+    static constexpr std::expected<T, AccessError> ok(const T& value) { return value; }
+
+    template <typename T>
+    static constexpr std::expected<T, AccessError> fail(const AccessError& error) {
+        return std::unexpected(error);
+    }
+};
+#endif
+
+struct AssertOnError {
+#ifdef NDEBUG
+    static constexpr bool checks = false;   // Release: zero-cost, like foo_assert
+#else
+    static constexpr bool checks = true;
+#endif
+    template <typename T> using Result = T;
+
+    template <typename T>
+    static constexpr T ok(const T& value) { return value; }
+
+    template <typename T>
+    static T fail(const AccessError&) {
+        assert(false && "Index out of bounds");
+        return T();
+    }
+};
+
+struct Unchecked {
+    static constexpr bool checks = false;
+    template <typename T> using Result = T;
+
+    template <typename T>
+    static constexpr T ok(const T& value) { return value; }
+
+    template <typename T>
+    static T fail(const AccessError&) { return T(); }   // Never called
+};
+
+template <typename T, typename CheckPolicy = ThrowOnError, std::size_t Extent = std::dynamic_extent>
+class SafeArray {
+private:
+    T* data_;
+    std::size_t size_;
+
+public:
+    using Result = typename CheckPolicy::template Result<T>;
+
+    constexpr SafeArray(T* data, std::size_t size)
+        requires(Extent == std::dynamic_extent)
+        : data_(data), size_(size) {}
+
+    constexpr SafeArray(T (&array)[Extent == std::dynamic_extent ? 1 : Extent])
+        requires(Extent != std::dynamic_extent)
+        : data_(array), size_(Extent) {}
+
+    constexpr SafeArray(std::array<T, Extent == std::dynamic_extent ? 1 : Extent>& array)
+        requires(Extent != std::dynamic_extent)
+        : data_(array.data()), size_(Extent) {}
+
+    // Storage for n value-initialized elements from an arena; freed by arena.reset()
+    static SafeArray fromArena(MonotonicArena& arena, std::size_t n, std::size_t align = alignof(T))
+        requires(Extent == std::dynamic_extent)
+    {
+        return SafeArray(arena.allocateArray<std::remove_const_t<T>>(n, align), n);
+    }
+
+    constexpr std::size_t size() const {
+        return Extent == std::dynamic_extent ? size_ : Extent;
+    }
+
+    constexpr T* data() const { return data_; }
+
+    constexpr Result get(int base, int off) const {
+        long long index = static_cast<long long>(base) + off;   // Cannot overflow
+        if constexpr (CheckPolicy::checks) {
+            if (data_ == nullptr) {
+                return CheckPolicy::template fail<T>(AccessError{AccessError::Kind::NullPointer, index, size()});
+            }
+            if (static_cast<unsigned long long>(index) >= size()) {   // Also catches index < 0
+                return CheckPolicy::template fail<T>(AccessError{AccessError::Kind::OutOfBounds, index, size()});
+            }
+        }
+        return CheckPolicy::ok(data_[index]);
+    }
+
+    // Bounds proven at compile time: no run-time check at all, whatever the policy
+    template <int Base, int Off>
+    constexpr T& at() const
+        requires(Extent != std::dynamic_extent)
+    {
+        constexpr long long index = static_cast<long long>(Base) + Off;
+        static_assert(index >= 0 && static_cast<unsigned long long>(index) < Extent, "Index out of bounds");
+        return data_[index];
+    }
+
+    // Batch get: returns the index of the first failing element, or bases.size() if all are valid
+    std::size_t getBatch(std::span<const int> bases, std::span<const int> offs, std::span<int> out) const
+        requires std::is_same_v<std::remove_const_t<T>, int>
+    {
+        if (data_ == nullptr) {
             throw std::runtime_error("Array data is null");
         }
-        int index = base + off;
-        if (index < 0 || static_cast<size_t>(index) >= size) {
-            throw std::out_of_range("Index out of bounds");
+        if (bases.size() != offs.size() || out.size() < bases.size()) {
+            throw std::invalid_argument("Batch spans have different lengths");
         }
-        return data[index];
+        constexpr std::size_t chunk = 1024;   // Elements validated per stack-sized mask
+        std::uint64_t mask[gatherMaskWords(chunk)];
+        for (std::size_t first = 0; first < bases.size(); first += chunk) {
+            std::size_t n = bases.size() - first < chunk ? bases.size() - first : chunk;
+            if (gatherBest(data_, size(), bases.data() + first, offs.data() + first, out.data() + first, mask, n) != n) {
+                return first + firstInvalid(mask, n);
+            }
+        }
+        return bases.size();
     }
 };
 
+// SafeArray safe{arr, size} keeps working; arrays get their size in the type
+template <typename T>
+SafeArray(T*, std::size_t) -> SafeArray<T>;
+
+template <typename T, std::size_t N>
+SafeArray(T (&)[N]) -> SafeArray<T, ThrowOnError, N>;
+
+template <typename T, std::size_t N>
+SafeArray(std::array<T, N>&) -> SafeArray<T, ThrowOnError, N>;
+
+// Approach 5: std::expected return type (C++23)
+// The error says what went wrong, which index was requested and the array size
+#if defined(__cpp_lib_expected)
+std::expected<int, AccessError> foo_expected(int *a, int base, int off, size_t size) {
+    long long index = static_cast<long long>(base) + off;   // Cannot overflow
+    if (a == nullptr) {
+        return std::unexpected(AccessError{AccessError::Kind::NullPointer, index, size});
+    }
+    if (static_cast<unsigned long long>(index) >= size) {
+        return std::unexpected(AccessError{AccessError::Kind::OutOfBounds, index, size});
+    }
+    return a[index];
+}
+#endif
+
+/*
+===============================================================================
+FIXED-SIZE OVERLOADS - N travels in the type, not as a size_t argument
+===============================================================================
+- Overloads of approaches 1, 2, 3 and 5 without a size parameter: N is part
+  of the argument type, and a reference cannot be null, so the whole check
+  is ONE unsigned compare of the long long index against a constant
+- With constant indices that compare folds away after inlining
+- foo_const(arr, {base, off}) goes further: the braced pair becomes a
+  ConstIndex<N> through a consteval constructor, so a bad constant index
+  is a compile error and the access is a plain load
+
+tools/bounds_asm_check.sh (ctest: bounds_asm_check) compiles callers of
+these overloads with -O2 -S and checks the generated code:
+- a function returning foo_exception(table, 1, 2) for a global int table[5]
+  compiles to a single load: no cmp, no call to the throw path
+- with runtime base/off the only check left is (x86-64, GCC 12)
+      addq  %rsi, %rdi
+      cmpq  $4, %rdi     ; N - 1, unsigned
+      ja    <throw>
+===============================================================================
+*/
+
+// Overflow-free index and its single unsigned range check
+constexpr long long fixedIndex(int base, int off) { return static_cast<long long>(base) + off; }
+
+template <std::size_t N>
+constexpr bool fixedIndexOk(long long index) { return static_cast<unsigned long long>(index) < N; }
+
+template <typename T, std::size_t N>
+constexpr T& foo_assert(T (&a)[N], int base, int off) {
+    assert(fixedIndexOk<N>(fixedIndex(base, off)) && "Index out of bounds");
+    return a[fixedIndex(base, off)];
+}
+
+template <typename T, std::size_t N>
+constexpr T& foo_exception(T (&a)[N], int base, int off) {
+    long long index = fixedIndex(base, off);
+    if (!fixedIndexOk<N>(index)) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return a[index];
+}
+
+template <typename T, std::size_t N>
+constexpr std::optional<std::remove_const_t<T>> foo_optional(T (&a)[N], int base, int off) {
+    long long index = fixedIndex(base, off);
+    if (!fixedIndexOk<N>(index)) return std::nullopt;
+    return a[index];
+}
+
+#if defined(__cpp_lib_expected)
+template <typename T, std::size_t N>
+constexpr std::expected<std::remove_const_t<T>, AccessError> foo_expected(T (&a)[N], int base, int off) {
+    long long index = fixedIndex(base, off);
+    if (!fixedIndexOk<N>(index)) {
+        return std::unexpected(AccessError{AccessError::Kind::OutOfBounds, index, N});
+    }
+    return a[index];
+}
+#endif
+
+// std::array versions: the same single compare, written out again because
+// binding a.data() to T (&)[N] would need a reinterpret_cast (not constexpr)
+template <typename T, std::size_t N>
+constexpr T& foo_assert(std::array<T, N>& a, int base, int off) {
+    assert(fixedIndexOk<N>(fixedIndex(base, off)) && "Index out of bounds");
+    return a[static_cast<std::size_t>(fixedIndex(base, off))];
+}
+
+template <typename T, std::size_t N>
+constexpr T& foo_exception(std::array<T, N>& a, int base, int off) {
+    long long index = fixedIndex(base, off);
+    if (!fixedIndexOk<N>(index)) {
+        throw std::out_of_range("Index out of bounds");
+    }
+    return a[static_cast<std::size_t>(index)];
+}
+
+template <typename T, std::size_t N>
+constexpr std::optional<T> foo_optional(const std::array<T, N>& a, int base, int off) {
+    long long index = fixedIndex(base, off);
+    if (!fixedIndexOk<N>(index)) return std::nullopt;
+    return a[static_cast<std::size_t>(index)];
+}
+
+#if defined(__cpp_lib_expected)
+template <typename T, std::size_t N>
+constexpr std::expected<T, AccessError> foo_expected(const std::array<T, N>& a, int base, int off) {
+    long long index = fixedIndex(base, off);
+    if (!fixedIndexOk<N>(index)) {
+        return std::unexpected(AccessError{AccessError::Kind::OutOfBounds, index, N});
+    }
+    return a[static_cast<std::size_t>(index)];
+}
+#endif
+
+// An index into an N-element array whose bounds were proven by the compiler
+template <std::size_t N>
+struct ConstIndex {
+    std::size_t value;
+
+    consteval ConstIndex(int base, int off) : value(static_cast<std::size_t>(fixedIndex(base, off))) {
+        if (!fixedIndexOk<N>(fixedIndex(base, off))) {
+            throw std::out_of_range("Index out of bounds");   // Not a constant expression: compile error
+        }
+    }
+};
+
+// foo_const(arr, {1, 2}): N comes from the array, the pair must be constant
+template <typename T, std::size_t N>
+constexpr T& foo_const(T (&a)[N], std::type_identity_t<ConstIndex<N>> index) {
+    return a[index.value];
+}
+
+template <typename T, std::size_t N>
+constexpr T& foo_const(std::array<T, N>& a, std::type_identity_t<ConstIndex<N>> index) {
+    return a[index.value];
+}
+
+/*
+===============================================================================
+BATCH VARIANTS (millions of lookups)
+===============================================================================
+- foo_exception_batch, foo_optional_batch and SafeArray::getBatch take spans
+  of bases and offsets, validate them with the branch-free SIMD kernels of
+  safe_gather.h and either report a validity bitmask or the first failing
+  element - one branch per batch instead of one per lookup
+===============================================================================
+*/
+
+constexpr std::size_t kGatherChunk = 1024;   // Elements validated per stack-sized mask
+
+// Batch foo_exception: fills out[] and throws for the first bad element, if any
+void foo_exception_batch(int *a, std::span<const int> bases, std::span<const int> offs,
+                         size_t size, std::span<int> out) {
+    if (a == nullptr) {
+        throw std::invalid_argument("Pointer cannot be null");
+    }
+    if (bases.size() != offs.size() || out.size() < bases.size()) {
+        throw std::invalid_argument("Batch spans have different lengths");
+    }
+    std::uint64_t mask[gatherMaskWords(kGatherChunk)];
+    for (std::size_t first = 0; first < bases.size(); first += kGatherChunk) {
+        std::size_t n = std::min(kGatherChunk, bases.size() - first);
+        if (gatherBest(a, size, bases.data() + first, offs.data() + first, out.data() + first, mask, n) != n) {
+            throw std::out_of_range("Index out of bounds at batch element " +
+                                    std::to_string(first + firstInvalid(mask, n)));
+        }
+    }
+}
+
+// Batch foo_optional: bit i of mask is has_value() of element i; returns the valid count
+std::size_t foo_optional_batch(int *a, std::span<const int> bases, std::span<const int> offs,
+                               size_t size, std::span<int> out, std::span<std::uint64_t> mask) {
+    assert(bases.size() == offs.size() && out.size() >= bases.size() &&
+           mask.size() >= gatherMaskWords(bases.size()) && "Batch spans too small");
+    return gatherBest(a, size, bases.data(), offs.data(), out.data(), mask.data(), bases.size());
+}
+
+#ifndef HW1_3_NO_MAIN
+
+// SafeArray checks also work during constant evaluation
+constexpr int kTable[] = {1, 2, 3};
+static_assert(SafeArray<const int, OptionalOnError>(kTable, 3).get(1, 1) == 3);
+static_assert(!SafeArray<const int, OptionalOnError>(kTable, 3).get(2, 1).has_value());
+
+// So do the fixed-size foo_* overloads: the size comes from the array type
+static_assert(foo_optional(kTable, 1, 1) == 3);
+static_assert(!foo_optional(kTable, INT_MAX, 1).has_value());
+static_assert(foo_const(kTable, {0, 2}) == 3);
+
 int main() {
     int arr[] = {10, 20, 30, 40, 50};
     size_t size = sizeof(arr) / sizeof(arr[0]);
     
     // Test all approaches
     try {
-        std::cout << "Assert approach: " << foo_assert(arr, 1, 2, size) << std::endl;
-        std::cout << "Exception approach: " << foo_exception(arr, 1, 2, size) << std::endl;
+        // arr is int[5]: these overloads take the size from the type
+        std::cout << "Assert approach: " << foo_assert(arr, 1, 2) << std::endl;
+        std::cout << "Exception approach: " << foo_exception(arr, 1, 2) << std::endl;
         
-        auto result = foo_optional(arr, 1, 2, size);
+        auto result = foo_optional(arr, 1, 2);
         std::cout << "Optional approach: " << (result ? std::to_string(*result) : "nullopt") << std::endl;
         
+        std::cout << "Compile-time checked foo_const(arr, {1, 2}): " << foo_const(arr, {1, 2}) << std::endl;
+        // foo_const(arr, {4, 1});   // Would not compile: ConstIndex<5> is consteval
+        
+        // Pointer + size versions, for arrays whose size is only known at run time
+        std::cout << "Exception approach (pointer, size): " << foo_exception(arr, 1, 2, size) << std::endl;
+        
+#if defined(__cpp_lib_expected)
+        auto expected = foo_expected(arr, 4, 3);
+        if (expected) {
+            std::cout << "Expected approach: " << *expected << std::endl;
+        } else {
+            std::cout << "Expected approach: index " << expected.error().index
+                      << " is out of bounds for size " << expected.error().size << std::endl;
+        }
+#endif
+        
         SafeArray safe{arr, size};
         std::cout << "Safe wrapper: " << safe.get(1, 2) << std::endl;
         
+        // Same wrapper, other policies: INT_MAX + 1 is caught without overflowing
+        SafeArray<int, OptionalOnError> maybe{arr, size};
+        auto missing = maybe.get(INT_MAX, 1);
+        std::cout << "Optional policy (INT_MAX + 1): " << (missing ? std::to_string(*missing) : "nullopt") << std::endl;
+        
+        // Storage from an arena instead of a hand-managed pointer: one reset frees it all
+        MonotonicArena arena;
+        auto pooled = SafeArray<int>::fromArena(arena, size);
+        for (size_t i = 0; i < size; ++i) pooled.data()[i] = arr[i];
+        std::cout << "Arena-backed wrapper: " << pooled.get(1, 2) << " (" << arena.stats().bytesInUse
+                  << " bytes in use, " << arena.stats().blocks << " block)" << std::endl;
+        arena.reset();
+        
+        SafeArray fixed{arr};   // Size 5 is part of the type: at<>() is checked by the compiler
+        std::cout << "Compile-time checked at<1, 2>: " << fixed.at<1, 2>() << std::endl;
+        // fixed.at<4, 1>();    // Would not compile: static_assert "Index out of bounds"
+        
+        // Batch variants: one SIMD-validated pass over many (base, off) pairs
+        std::vector<int> bases = {0, 1, 2, 3, 4, 2};
+        std::vector<int> offs  = {0, 1, 1, 1, 0, 9};   // Last pair is out of bounds
+        std::vector<int> out(bases.size());
+        std::uint64_t mask[1];
+        size_t valid = foo_optional_batch(arr, bases, offs, size, out, mask);
+        std::cout << "Optional batch: " << valid << " of " << bases.size()
+                  << " valid, mask 0x" << std::hex << mask[0] << std::dec << std::endl;
+        std::cout << "Safe wrapper batch: first failing element " << safe.getBatch(bases, offs, out) << std::endl;
+        
+        // The exception batch gets only the valid pairs: it would throw for element 5
+        std::span<const int> goodBases(bases.data(), 5), goodOffs(offs.data(), 5);
+        foo_exception_batch(arr, goodBases, goodOffs, size, out);
+        std::cout << "Exception batch:";
+        for (size_t i = 0; i < goodBases.size(); ++i) std::cout << ' ' << out[i];
+        std::cout << std::endl;
+        
         // Test error cases
         // foo_assert(nullptr, 0, 0, size);  // Would trigger assert
         // foo_exception(nullptr, 0, 0, size);  // Would throw exception
@@ -84,3 +531,5 @@ int main() {
     
     return 0;
 }
+
+#endif  // HW1_3_NO_MAIN
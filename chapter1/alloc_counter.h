@@ -0,0 +1,36 @@
+/*
+===============================================================================
+TITLE: Global heap allocation counter
+TOPIC: Make hidden allocations visible
+
+Replaces the global operator new / operator delete so every heap allocation
+in the program is counted. Include it in exactly ONE translation unit of a
+program (all demos here are single-file programs).
+
+    std::size_t before = allocationCount();
+    print(std::vector<int>{2});
+    std::size_t allocations = allocationCount() - before;   // 1
+===============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+inline std::atomic<std::size_t> gAllocationCount{0};
+
+inline std::size_t allocationCount() {
+    return gAllocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
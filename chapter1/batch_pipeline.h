@@ -0,0 +1,284 @@
+/*
+===============================================================================
+TITLE: Parallel batch pipeline for processCriticalData
+TOPIC: One flag read and a handful of log lines per BATCH, not per record
+
+    WorkStealingPool pool;                       // hardware_concurrency workers
+    BatchReport report = processCriticalBatch(pool, logger, records.data(), records.size(), featureEnabled);
+
+PER-RECORD VERSION (debug_vs_release_bug.cpp):
+- Reads featureEnabled and makes up to seven synchronous log calls for
+  every single record - the logging is the work
+
+BATCH VERSION:
+- The caller reads the feature flag ONCE and passes it in
+- Every record still goes through processCriticalData's branch,
+  runCriticalPath (critical_path.h), but with a per-worker TallySink
+  logger: its log events are counted in the worker's own cache line
+  instead of being formatted and written
+- The records are cut into chunks of `grain` records; each worker owns a
+  deque of chunks and takes them from the front, an idle worker steals
+  from the back of another worker's deque (mutex per deque, only touched
+  once per chunk, so the lock is never the bottleneck)
+- After the batch the tallies are merged and logged as a few summary lines
+- The calling thread is worker 0, so a pool of 1 runs everything inline
+
+STAND-IN WORKLOAD:
+- The demo's "critical processing" is a console line. A batch needs real
+  per-record work to scale, so processCriticalRecord (a 64-bit mixer over
+  the record's payload) stands in for it; it is not part of the demo
+
+Header-only, C++17 (pointer + count, no std::span).
+benchmarks/batch_bench.cpp: records/s for 1 .. hardware_concurrency threads.
+===============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "critical_path.h"
+#include "log_levels.h"
+
+/*
+===============================================================================
+WORK-STEALING POOL
+===============================================================================
+*/
+
+class WorkStealingPool {
+private:
+    struct Chunk {
+        std::size_t begin;
+        std::size_t end;
+    };
+
+    struct alignas(64) Queue {
+        std::mutex lock;
+        std::deque<Chunk> chunks;
+    };
+
+    // The current job, type-erased without an allocation
+    using Invoke = void (*)(void* body, unsigned worker, std::size_t begin, std::size_t end);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex stateLock;
+    std::condition_variable wake;
+    std::condition_variable finished;
+    std::uint64_t generation = 0;
+    unsigned running = 0;
+    bool stopping = false;
+    void* body = nullptr;
+    Invoke invoke = nullptr;
+    std::atomic<std::size_t> steals{0};
+
+    bool popOwn(unsigned worker, Chunk& chunk) {
+        Queue& queue = *queues[worker];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.chunks.empty()) return false;
+        chunk = queue.chunks.front();
+        queue.chunks.pop_front();
+        return true;
+    }
+
+    bool steal(unsigned worker, Chunk& chunk) {
+        for (std::size_t offset = 1; offset < queues.size(); ++offset) {
+            Queue& victim = *queues[(worker + offset) % queues.size()];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.chunks.empty()) continue;
+            chunk = victim.chunks.back();
+            victim.chunks.pop_back();
+            steals.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    // Chunks are all queued before the batch starts, so once every deque is
+    // empty this worker has nothing left to do in this batch
+    void drain(unsigned worker) {
+        Chunk chunk;
+        while (popOwn(worker, chunk) || steal(worker, chunk)) {
+            invoke(body, worker, chunk.begin, chunk.end);
+        }
+    }
+
+    void workerLoop(unsigned worker) {
+        std::uint64_t seen = 0;
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> guard(stateLock);
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            drain(worker);
+            std::lock_guard<std::mutex> guard(stateLock);
+            if (--running == 0) finished.notify_one();
+        }
+    }
+
+public:
+    explicit WorkStealingPool(unsigned workers = std::thread::hardware_concurrency()) {
+        workers = std::max(workers, 1u);
+        for (unsigned i = 0; i < workers; ++i) queues.emplace_back(new Queue);
+        for (unsigned i = 1; i < workers; ++i) threads.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> guard(stateLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : threads) thread.join();
+    }
+
+    unsigned size() const { return static_cast<unsigned>(queues.size()); }
+    std::size_t stealCount() const { return steals.load(std::memory_order_relaxed); }
+
+    // Calls chunkBody(worker, begin, end) for [0, count) in chunks of grain
+    // items and returns when all of them are done. Worker 0 is the caller;
+    // one parallelFor at a time per pool
+    template <typename F>
+    void parallelFor(std::size_t count, std::size_t grain, F&& chunkBody) {
+        if (count == 0) return;
+        grain = std::max<std::size_t>(grain, 1);
+        std::size_t chunkCount = (count + grain - 1) / grain;
+
+        // Contiguous runs of chunks per worker: each starts on its own part
+        // of the range and only steals once that part is used up
+        for (unsigned worker = 0; worker < size(); ++worker) {
+            std::size_t first = chunkCount * worker / size();
+            std::size_t last = chunkCount * (worker + 1) / size();
+            std::lock_guard<std::mutex> guard(queues[worker]->lock);
+            for (std::size_t chunk = first; chunk < last; ++chunk) {
+                queues[worker]->chunks.push_back(Chunk{chunk * grain, std::min(count, (chunk + 1) * grain)});
+            }
+        }
+
+        body = &chunkBody;
+        invoke = [](void* target, unsigned worker, std::size_t begin, std::size_t end) {
+            (*static_cast<std::remove_reference_t<F>*>(target))(worker, begin, end);
+        };
+        if (!threads.empty()) {
+            {
+                std::lock_guard<std::mutex> guard(stateLock);
+                running = static_cast<unsigned>(threads.size());
+                ++generation;
+            }
+            wake.notify_all();
+        }
+        drain(0);
+        std::unique_lock<std::mutex> guard(stateLock);
+        finished.wait(guard, [&] { return running == 0; });
+    }
+};
+
+/*
+===============================================================================
+BATCH PROCESSING
+===============================================================================
+*/
+
+struct CriticalRecord {
+    std::uint64_t id;
+    std::uint64_t payload;
+    std::uint64_t result = 0;   // Written by the critical path only
+};
+
+// Stand-in for the demo's critical processing: a few rounds of a 64-bit mixer
+inline std::uint64_t processCriticalRecord(std::uint64_t payload) {
+    for (int round = 0; round < 4; ++round) {
+        payload ^= payload >> 30;
+        payload *= 0xbf58476d1ce4e5b9ull;
+        payload ^= payload >> 27;
+        payload *= 0x94d049bb133111ebull;
+        payload ^= payload >> 31;
+    }
+    return payload;
+}
+
+struct BatchReport {
+    std::size_t records = 0;
+    std::size_t processed = 0;     // Took the critical path
+    std::size_t skipped = 0;       // Critical processing was skipped
+    unsigned workers = 0;
+    std::uint64_t checksum = 0;    // XOR of all results: equal for any worker count
+    std::size_t logEvents = 0;     // Per-record events folded into the summary lines
+};
+
+// What one worker would have logged, as counters in its own cache line
+struct alignas(64) WorkerTally {
+    std::size_t processed = 0;
+    std::size_t skipped = 0;
+    std::uint64_t checksum = 0;
+    std::size_t logEvents = 0;
+};
+
+// StaticLogger sink that only counts: runCriticalPath logs into it per record
+struct TallySink {
+    WorkerTally& tally;
+
+    template <typename... Args>
+    void write(LogLevel, const LogFormat&, const Args&...) { ++tally.logEvents; }
+};
+
+using TallyLogger = StaticLogger<LogLevel::Trace, TallySink>;
+
+template <typename BatchLogger>
+BatchReport processCriticalBatch(WorkStealingPool& pool, BatchLogger& logger, CriticalRecord* records,
+                                 std::size_t count, bool featureEnabled, std::size_t grain = 4096) {
+    std::vector<WorkerTally> tallies(pool.size());
+
+    pool.parallelFor(count, grain, [&](unsigned worker, std::size_t begin, std::size_t end) {
+        WorkerTally& tally = tallies[worker];
+        TallyLogger tallyLogger{TallySink{tally}};
+        for (std::size_t i = begin; i < end; ++i) {
+            CriticalRecord& record = records[i];
+            runCriticalPath(tallyLogger, featureEnabled ? 1 : 0,
+                [&] {
+                    record.result = processCriticalRecord(record.payload);
+                    tally.checksum ^= record.result;
+                    ++tally.processed;
+                },
+                [&] { ++tally.skipped; });
+        }
+    });
+
+    BatchReport report;
+    report.records = count;
+    report.workers = pool.size();
+    for (const WorkerTally& tally : tallies) {
+        report.processed += tally.processed;
+        report.skipped += tally.skipped;
+        report.checksum ^= tally.checksum;
+        report.logEvents += tally.logEvents;
+    }
+
+    // The same events as processCriticalData, once per batch with counts
+    LOG_DEBUG(logger, "Batch of {} records, featureEnabled read once: {}", report.records, featureEnabled ? 1 : 0);
+    LOG_DEBUG(logger, "{} per-record log events summarized below", report.logEvents);
+    if (featureEnabled) {
+        LOG_INFO(logger, "IF CONDITION: featureEnabled is TRUE - executing critical path for {} records", report.records);
+        LOG_INFO(logger, "Critical processing completed successfully for {} records", report.processed);
+    } else {
+        LOG_INFO(logger, "IF CONDITION: featureEnabled is FALSE - skipping critical path for {} records", report.records);
+        LOG_WARN(logger, "WARNING: Critical processing was skipped for {} records!", report.skipped);
+    }
+    return report;
+}
@@ -0,0 +1,118 @@
+/*
+===============================================================================
+TITLE: Error-path cost of the HW1_3 approaches
+TOPIC: Exceptions vs optional vs expected when bad indices are common
+
+For each bad-index ratio (0% .. 50%) every approach performs the same
+lookups; a bad lookup is counted instead of read. Reported: ns per lookup.
+
+- foo_assert only runs at 0%: a bad index aborts (debug) or reads out of
+  bounds (release), there is no error path to measure
+- foo_exception and SafeArray::get pay for a throw + unwind per bad index
+- foo_optional and foo_expected return normally; foo_expected also carries
+  the index and size of the failure
+===============================================================================
+*/
+
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#define HW1_3_NO_MAIN
+#include "../HW1_3_solution.cpp"   // foo_* approaches, SafeArray and batch variants
+#include "bench.h"
+
+struct Workload {
+    std::vector<int> array;
+    std::vector<int> bases;
+    std::vector<int> offs;
+};
+
+Workload makeWorkload(double badRatio) {
+    const std::size_t lookups = 1 << 16;
+    Workload work;
+    work.array.resize(1024);
+    for (std::size_t i = 0; i < work.array.size(); ++i) work.array[i] = static_cast<int>(i);
+
+    std::mt19937 rng(11);
+    std::bernoulli_distribution bad(badRatio);
+    for (std::size_t i = 0; i < lookups; ++i) {
+        work.bases.push_back(static_cast<int>(rng() % 512));
+        work.offs.push_back(bad(rng) ? 4096 : static_cast<int>(rng() % 512));
+    }
+    return work;
+}
+
+template <typename F>
+double perLookup(Workload& work, F&& lookup) {
+    BenchResult result = runBench("", 20, [&](std::size_t) {
+        long long sum = 0;
+        for (std::size_t i = 0; i < work.bases.size(); ++i) sum += lookup(work.bases[i], work.offs[i]);
+        doNotOptimize(sum);
+    });
+    return result.nsPerOp / static_cast<double>(work.bases.size());
+}
+
+int main() {
+    const double ratios[] = {0.0, 0.01, 0.05, 0.10, 0.25, 0.50};
+
+    std::printf("%-8s %12s %12s %12s %12s %12s\n", "bad", "assert", "exception", "optional",
+                "SafeArray", "expected");
+    for (double ratio : ratios) {
+        Workload work = makeWorkload(ratio);
+        int* a = work.array.data();
+        std::size_t size = work.array.size();
+        SafeArray safe{a, size};
+
+        double assertNs = -1;
+        if (ratio == 0.0) {
+            assertNs = perLookup(work, [&](int base, int off) { return foo_assert(a, base, off, size); });
+        }
+        double exceptionNs = perLookup(work, [&](int base, int off) {
+            try {
+                return foo_exception(a, base, off, size);
+            } catch (const std::out_of_range&) {
+                return -1;
+            }
+        });
+        double optionalNs = perLookup(work, [&](int base, int off) {
+            std::optional<int> value = foo_optional(a, base, off, size);
+            return value ? *value : -1;
+        });
+        double safeNs = perLookup(work, [&](int base, int off) {
+            try {
+                return safe.get(base, off);
+            } catch (const std::out_of_range&) {
+                return -1;
+            }
+        });
+        double expectedNs = -1;
+#if defined(__cpp_lib_expected)
+        expectedNs = perLookup(work, [&](int base, int off) {
+            std::expected<int, AccessError> value = foo_expected(a, base, off, size);
+            return value ? *value : -1;
+        });
+#endif
+
+        std::printf("%6.0f%%  ", ratio * 100);
+        for (double ns : {assertNs, exceptionNs, optionalNs, safeNs, expectedNs}) {
+            if (ns < 0) std::printf(" %12s", "n/a");
+            else std::printf(" %12.2f", ns);
+        }
+        std::printf("   ns/lookup\n");
+    }
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+cmake -S . -B build && cmake --build build     # from chapter1, C++23
+./build/access_bench
+
+or directly:
+clang++ -std=c++23 -O2 -DNDEBUG access_bench.cpp -o access_bench
+===============================================================================
+*/
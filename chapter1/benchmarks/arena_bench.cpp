@@ -0,0 +1,87 @@
+/*
+===============================================================================
+TITLE: Arena vs new[] vs std::vector churn
+TOPIC: Thousands of small arrays created and dropped per request
+
+One "request" creates 1000 small int arrays (4..64 elements), fills them,
+reads one element of each through SafeArray::get and then drops them all.
+Reported: ns per request and per array.
+
+- new[]/delete[]   : one heap allocation and free per array
+- std::vector      : same, plus the vector object itself
+- MonotonicArena   : pointer bumps, one reset() per request
+===============================================================================
+*/
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+#define HW1_3_NO_MAIN
+#include "../HW1_3_solution.cpp"   // SafeArray and its check policies
+#include "bench.h"
+
+constexpr std::size_t kArraysPerRequest = 1000;
+
+int main() {
+    std::mt19937 rng(3);
+    std::vector<std::size_t> sizes(kArraysPerRequest);
+    for (std::size_t& size : sizes) size = 4 + rng() % 61;
+    const std::size_t requests = 2000;
+
+    auto perRequest = [](BenchResult result) {
+        printResult(result);
+        std::printf("    %.1f ns per array\n", result.nsPerOp / kArraysPerRequest);
+    };
+
+    perRequest(runBench("new[] / delete[]", requests, [&](std::size_t) {
+        std::vector<std::unique_ptr<int[]>> arrays;
+        arrays.reserve(kArraysPerRequest);
+        long long sum = 0;
+        for (std::size_t size : sizes) {
+            arrays.emplace_back(new int[size]());
+            arrays.back()[size - 1] = static_cast<int>(size);
+            sum += SafeArray<int>(arrays.back().get(), size).get(static_cast<int>(size) - 1, 0);
+        }
+        doNotOptimize(sum);
+    }));
+
+    perRequest(runBench("std::vector", requests, [&](std::size_t) {
+        std::vector<std::vector<int>> arrays;
+        arrays.reserve(kArraysPerRequest);
+        long long sum = 0;
+        for (std::size_t size : sizes) {
+            arrays.emplace_back(size);
+            arrays.back()[size - 1] = static_cast<int>(size);
+            sum += SafeArray<int>(arrays.back().data(), size).get(static_cast<int>(size) - 1, 0);
+        }
+        doNotOptimize(sum);
+    }));
+
+    MonotonicArena arena;
+    perRequest(runBench("MonotonicArena + reset()", requests, [&](std::size_t) {
+        long long sum = 0;
+        for (std::size_t size : sizes) {
+            SafeArray<int> array = SafeArray<int>::fromArena(arena, size);
+            array.data()[size - 1] = static_cast<int>(size);
+            sum += array.get(static_cast<int>(size) - 1, 0);
+        }
+        doNotOptimize(sum);
+        arena.reset();
+    }));
+
+    const ArenaStats& stats = arena.stats();
+    std::printf("arena: %zu allocations, %zu resets, %zu blocks, %zu bytes reserved, peak %zu bytes in use\n",
+                stats.allocations, stats.resets, stats.blocks, stats.bytesReserved, stats.peakBytesInUse);
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++23 -O2 -DNDEBUG arena_bench.cpp -o arena_bench
+./arena_bench
+===============================================================================
+*/
@@ -0,0 +1,147 @@
+/*
+===============================================================================
+TITLE: Batch pipeline scaling
+TOPIC: Records per second from 1 to hardware_concurrency threads
+
+CASES:
+1. per record  - processCriticalData's body (runCriticalPath) per record:
+                 the flag is read and five log lines are formatted for
+                 every record, one thread
+2. batch, N    - processCriticalBatch on a WorkStealingPool of N workers:
+                 one flag read, the same runCriticalPath per record into
+                 per-worker tallies, summary lines per batch
+3. demo batch  - what debug_vs_release_bug.cpp used to run as its Part 3:
+                 100000 records on a fresh hardware_concurrency pool, pool
+                 start-up and shutdown included
+
+Log lines are formatted exactly like the file sinks do (formatLogLine) and
+then counted instead of written, so the numbers compare processing and
+formatting work, not disk speed. Every batch run must produce the same
+checksum as the single-threaded one.
+
+USAGE:
+    ./batch_bench [records]
+===============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "../batch_pipeline.h"
+#include "bench.h"
+
+// Formats each line like FileSink, then drops it
+struct CountingSink {
+    std::size_t lines = 0;
+    std::size_t bytes = 0;
+
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        char line[kLogLineText];
+        bytes += formatLogLine(line, format, args...);
+        ++lines;
+        doNotOptimize(line);
+    }
+};
+
+using BenchLogger = StaticLogger<LogLevel::Debug, CountingSink>;
+
+// processCriticalData applied to one record: the flag is read and every
+// log line is formatted per record
+void processOneRecord(BenchLogger& logger, CriticalRecord& record, const volatile int& featureEnabled) {
+    int flag = featureEnabled;
+    LOG_DEBUG(logger, "Variable 'featureEnabled' declared but not initialized");
+    LOG_DEBUG(logger, "Value of featureEnabled: {}", flag);
+    runCriticalPath(logger, flag, [&] { record.result = processCriticalRecord(record.payload); }, [] {});
+    LOG_DEBUG(logger, "Record {} done", record.id);
+}
+
+double secondsOf(std::chrono::steady_clock::duration elapsed) {
+    return std::chrono::duration<double>(elapsed).count();
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    const int repeats = 5;
+    std::vector<CriticalRecord> records(count);
+    for (std::size_t i = 0; i < count; ++i) records[i] = CriticalRecord{i, i * 0x9e3779b97f4a7c15ull};
+
+    unsigned hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::printf("%zu records, best of %d runs, hardware_concurrency = %u\n\n", count, repeats, hardware);
+    std::printf("%-24s %14s %10s %14s\n", "case", "records/s", "speedup", "log lines");
+
+    // 1. Per-record logging, single thread
+    {
+        BenchLogger logger{CountingSink{}};
+        volatile int featureEnabled = 1;
+        double best = 1e30;
+        for (int run = 0; run < repeats; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            for (CriticalRecord& record : records) processOneRecord(logger, record, featureEnabled);
+            best = std::min(best, secondsOf(std::chrono::steady_clock::now() - start));
+        }
+        std::printf("%-24s %14.0f %10s %14zu\n", "per record, 1 thread", count / best, "-",
+                    logger.sink<0>().lines / repeats);
+    }
+
+    // 2. Batch pipeline, 1, 2, 4, ... and hardware_concurrency workers
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < hardware; threads *= 2) threadCounts.push_back(threads);
+    threadCounts.push_back(hardware);
+
+    double singleThreaded = 0;
+    std::uint64_t expectedChecksum = 0;
+    for (unsigned threads : threadCounts) {
+        WorkStealingPool pool(threads);
+        BenchLogger logger{CountingSink{}};
+        double best = 1e30;
+        BatchReport report;
+        for (int run = 0; run < repeats; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            report = processCriticalBatch(pool, logger, records.data(), records.size(), true);
+            best = std::min(best, secondsOf(std::chrono::steady_clock::now() - start));
+        }
+        if (threads == 1) {
+            singleThreaded = best;
+            expectedChecksum = report.checksum;
+        } else if (report.checksum != expectedChecksum || report.processed != count) {
+            std::printf("batch with %u threads produced a different result\n", threads);
+            return 1;
+        }
+        char name[32];
+        std::snprintf(name, sizeof(name), "batch, %u thread%s", threads, threads == 1 ? "" : "s");
+        std::printf("%-24s %14.0f %9.2fx %14zu   (%zu chunks stolen)\n", name, count / best, singleThreaded / best,
+                    logger.sink<0>().lines / repeats, pool.stealCount());
+    }
+
+    // 3. The demo-sized batch, paying for the pool every time
+    {
+        std::vector<CriticalRecord> demoRecords(100000);
+        for (std::size_t i = 0; i < demoRecords.size(); ++i) demoRecords[i] = CriticalRecord{i, i * 2654435761u};
+        BenchLogger logger{CountingSink{}};
+        double best = 1e30;
+        for (int run = 0; run < repeats; ++run) {
+            auto start = std::chrono::steady_clock::now();
+            WorkStealingPool pool;
+            processCriticalBatch(pool, logger, demoRecords.data(), demoRecords.size(), true);
+            best = std::min(best, secondsOf(std::chrono::steady_clock::now() - start));
+        }
+        std::printf("%-24s %14.0f %10s %14zu   (%.0f us per batch with pool start-up)\n", "demo batch, 100k",
+                    demoRecords.size() / best, "-", logger.sink<0>().lines / repeats, best * 1e6);
+    }
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 -DNDEBUG -pthread batch_bench.cpp -o batch_bench
+./batch_bench            # 4M records
+./batch_bench 100000     # small batches: pool wake-up cost starts to show
+===============================================================================
+*/
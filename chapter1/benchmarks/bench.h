@@ -0,0 +1,226 @@
+/*
+===============================================================================
+TITLE: Minimal in-tree benchmark harness
+TOPIC: Measure a hot operation in nanoseconds per call
+
+USAGE:
+    BenchResult r = runBench("name", iterations, [&](std::size_t i) { ... });
+    printResult(r);
+
+- One warm-up pass of iterations/10 calls, then the timed loop
+- doNotOptimize() keeps results alive so the optimizer cannot delete the work
+
+MANY THREADS (mmap_log_bench.cpp, sharded_log_bench.cpp):
+    StressResult s = stressThreads(threads, perThread, [&](unsigned thread) { ... });
+- Every call is timed on its own: calls per second across all threads
+  and the p99 latency of one call
+
+JSON AND BASELINES (suite_bench.cpp):
+    writeJson("results.json", results);
+    compareToBaseline(results, readJson("baseline.json"), 0.15);
+- The file uses Google Benchmark's field names ("context", "host_name",
+  "num_cpus", "benchmarks", "name", "iterations", "real_time",
+  "time_unit"), so its compare.py reads it too
+- A baseline is only meaningful on the machine that recorded it: the
+  context says which one, sameMachine() checks it
+- A case regresses when it is more than `tolerance` slower than the
+  baseline AND at least 1 ns slower (sub-ns cases are all noise)
+===============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+struct BenchResult {
+    std::string name;
+    std::size_t iterations;
+    double nsPerOp;
+};
+
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename F>
+BenchResult runBench(const std::string& name, std::size_t iterations, F&& body) {
+    for (std::size_t i = 0; i < iterations / 10; ++i) body(i);
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) body(i);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    double ns = std::chrono::duration<double, std::nano>(elapsed).count();
+    return BenchResult{name, iterations, ns / static_cast<double>(iterations)};
+}
+
+inline void printResult(const BenchResult& result) {
+    if (result.nsPerOp < 0.05) {   // Loop body optimized away entirely
+        std::printf("%-44s %12.1f ns/op %14s ops/s\n", result.name.c_str(), result.nsPerOp, "-");
+        return;
+    }
+    std::printf("%-44s %12.1f ns/op %14.0f ops/s\n", result.name.c_str(), result.nsPerOp,
+                1e9 / result.nsPerOp);
+}
+
+/*
+===============================================================================
+THREADED LATENCY
+===============================================================================
+*/
+
+struct StressResult {
+    double opsPerSecond;     // All threads together
+    double p99Nanoseconds;   // One call
+};
+
+// `threads` threads each call body(thread) `perThread` times, every call timed
+template <typename F>
+StressResult stressThreads(unsigned threads, std::size_t perThread, F&& body) {
+    std::vector<std::vector<std::uint32_t>> latencies(threads, std::vector<std::uint32_t>(perThread));
+    std::vector<std::thread> workers;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::vector<std::uint32_t>& mine = latencies[t];
+            for (std::size_t i = 0; i < perThread; ++i) {
+                auto before = std::chrono::steady_clock::now();
+                body(t);
+                auto after = std::chrono::steady_clock::now();
+                mine[i] = static_cast<std::uint32_t>(
+                    std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count());
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<std::uint32_t> all;
+    all.reserve(threads * perThread);
+    for (const std::vector<std::uint32_t>& mine : latencies) all.insert(all.end(), mine.begin(), mine.end());
+    std::size_t p99 = all.size() * 99 / 100;
+    std::nth_element(all.begin(), all.begin() + static_cast<std::ptrdiff_t>(p99), all.end());
+
+    return StressResult{static_cast<double>(all.size()) / seconds, static_cast<double>(all[p99])};
+}
+
+/*
+===============================================================================
+JSON RESULTS AND BASELINE COMPARISON
+===============================================================================
+*/
+
+// Where a result was measured
+struct BenchContext {
+    std::string hostName;
+    unsigned cpus = 0;
+};
+
+inline BenchContext currentContext() {
+    char host[256] = {};
+    ::gethostname(host, sizeof(host) - 1);
+    return BenchContext{host, std::thread::hardware_concurrency()};
+}
+
+inline bool sameMachine(const BenchContext& a, const BenchContext& b) {
+    return a.hostName == b.hostName && a.cpus == b.cpus;
+}
+
+inline bool writeJson(const char* path, const std::vector<BenchResult>& results) {
+    std::FILE* out = std::fopen(path, "w");
+    if (out == nullptr) return false;
+    BenchContext context = currentContext();
+    std::fprintf(out, "{\n  \"context\": {\"host_name\": \"%s\", \"num_cpus\": %u},\n", context.hostName.c_str(),
+                 context.cpus);
+    std::fputs("  \"benchmarks\": [", out);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        std::fprintf(out, "%s\n    {\"name\": \"%s\", \"iterations\": %zu, \"real_time\": %.3f, \"time_unit\": \"ns\"}",
+                     i == 0 ? "" : ",", results[i].name.c_str(), results[i].iterations, results[i].nsPerOp);
+    }
+    std::fputs("\n  ]\n}\n", out);
+    return std::fclose(out) == 0;
+}
+
+inline std::string readWholeFile(const char* path) {
+    std::string text;
+    std::FILE* in = std::fopen(path, "r");
+    if (in == nullptr) return text;
+    char chunk[4096];
+    for (std::size_t n; (n = std::fread(chunk, 1, sizeof(chunk), in)) > 0;) text.append(chunk, n);
+    std::fclose(in);
+    return text;
+}
+
+// The "context" of a file written by writeJson (or Google Benchmark);
+// empty host name when it has none
+inline BenchContext readJsonContext(const char* path) {
+    std::string text = readWholeFile(path);
+    BenchContext context;
+    const std::string hostKey = "\"host_name\": \"";
+    const std::string cpusKey = "\"num_cpus\": ";
+    std::size_t host = text.find(hostKey);
+    if (host != std::string::npos) {
+        host += hostKey.size();
+        context.hostName = text.substr(host, text.find('"', host) - host);
+    }
+    std::size_t cpus = text.find(cpusKey);
+    if (cpus != std::string::npos) {
+        context.cpus = static_cast<unsigned>(std::strtoul(text.c_str() + cpus + cpusKey.size(), nullptr, 10));
+    }
+    return context;
+}
+
+// Reads back what writeJson wrote (or Google Benchmark output): only the
+// "name" and "real_time" of each entry, in nanoseconds as written
+inline std::vector<BenchResult> readJson(const char* path) {
+    std::vector<BenchResult> results;
+    std::string text = readWholeFile(path);
+
+    const std::string nameKey = "\"name\": \"";
+    const std::string timeKey = "\"real_time\": ";
+    for (std::size_t at = text.find(nameKey); at != std::string::npos; at = text.find(nameKey, at)) {
+        at += nameKey.size();
+        std::size_t nameEnd = text.find('"', at);
+        std::size_t time = text.find(timeKey, nameEnd);
+        if (nameEnd == std::string::npos || time == std::string::npos) break;
+        results.push_back(BenchResult{text.substr(at, nameEnd - at), 0,
+                                      std::strtod(text.c_str() + time + timeKey.size(), nullptr)});
+    }
+    return results;
+}
+
+// Prints one line per case; returns the number of regressions
+inline int compareToBaseline(const std::vector<BenchResult>& results, const std::vector<BenchResult>& baseline,
+                             double tolerance) {
+    int regressions = 0;
+    std::printf("\n%-44s %12s %12s %9s\n", "compared to baseline", "baseline", "now", "change");
+    for (const BenchResult& result : results) {
+        const BenchResult* old = nullptr;
+        for (const BenchResult& candidate : baseline) {
+            if (candidate.name == result.name) old = &candidate;
+        }
+        if (old == nullptr || old->nsPerOp <= 0) {
+            std::printf("%-44s %12s %9.1f ns %9s\n", result.name.c_str(), "new", result.nsPerOp, "");
+            continue;
+        }
+        double change = result.nsPerOp / old->nsPerOp - 1.0;
+        bool regressed = change > tolerance && result.nsPerOp - old->nsPerOp >= 1.0;
+        regressions += regressed ? 1 : 0;
+        std::printf("%-44s %9.1f ns %9.1f ns %+8.1f%%%s\n", result.name.c_str(), old->nsPerOp, result.nsPerOp,
+                    change * 100.0, regressed ? "  REGRESSION" : "");
+    }
+    return regressions;
+}
@@ -0,0 +1,67 @@
+/*
+===============================================================================
+TITLE: Text log vs binary log benchmark
+TOPIC: What does "Value of featureEnabled: " + std::to_string(x) really cost?
+
+CASES:
+1. text, to_string   - today's call site: two allocations + ofstream + std::endl
+2. text, LOG_FMT     - same output, formatted into a stack buffer
+3. binary, LOG_FMT   - format id + raw int appended to a buffer, no formatting
+
+Console echo of the text Logger is redirected to /dev/null so the numbers
+show the logging work, not the terminal.
+===============================================================================
+*/
+
+#include <cstdio>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../logger.h"
+#include "bench.h"
+
+int main() {
+    const std::size_t iterations = 200000;
+
+    // Keep the real stdout for the report; the Logger echoes into /dev/null
+    int report = ::dup(STDOUT_FILENO);
+    int devNull = ::open("/dev/null", O_WRONLY);
+    ::dup2(devNull, STDOUT_FILENO);
+
+    BenchResult results[3];
+    {
+        Logger logger;
+        results[0] = runBench("text, to_string + log()", iterations, [&](std::size_t i) {
+            logger.log("Value of featureEnabled: " + std::to_string(static_cast<int>(i)));
+        });
+    }
+    {
+        Logger logger;
+        results[1] = runBench("text, LOG_FMT", iterations, [&](std::size_t i) {
+            LOG_FMT(logger, "Value of featureEnabled: {}", static_cast<int>(i));
+        });
+    }
+    {
+        Logger logger{BinaryLogConfig{}};
+        results[2] = runBench("binary, LOG_FMT", iterations, [&](std::size_t i) {
+            LOG_FMT(logger, "Value of featureEnabled: {}", static_cast<int>(i));
+        });
+    }
+
+    std::fflush(stdout);
+    ::dup2(report, STDOUT_FILENO);
+    for (const BenchResult& result : results) printResult(result);
+    std::printf("binary speedup over text path: %.1fx\n", results[0].nsPerOp / results[2].nsPerOp);
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 -DNDEBUG binary_log_bench.cpp -o binary_log_bench
+./binary_log_bench
+===============================================================================
+*/
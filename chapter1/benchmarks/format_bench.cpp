@@ -0,0 +1,139 @@
+/*
+===============================================================================
+TITLE: Integer output throughput
+TOPIC: iostream vs printf vs std::println vs FormatBuffer
+
+Each case writes one integer plus '\n' per operation. The values are a
+mix of small and large, positive and negative numbers. Results are in
+integers per second. stdout is /dev/null and the report goes to stderr.
+
+CASES:
+1. std::cout << v << std::endl  - the original print(int) (flush per line)
+2. std::cout << v << '\n'       - iostream without the flush
+3. std::printf("%d\n", v)
+4. std::println("{}", v)        - C++23 only (<print>)
+5. FormatBuffer                 - digit pairs, one fwrite per 64 KB
+6. std::to_chars + FormatBuffer - same buffer, standard digit conversion
+
+Before timing, formatInteger is checked against std::to_chars, including
+the minimum and maximum values of each type.
+===============================================================================
+*/
+
+#include <charconv>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if __has_include(<print>)
+#include <print>
+#endif
+
+#include "../fast_format.h"
+#include "bench.h"
+
+template <typename T>
+bool sameAsToChars(T value) {
+    char expected[32];
+    char actual[32];
+    std::size_t expectedLength = static_cast<std::size_t>(std::to_chars(expected, expected + 32, value).ptr - expected);
+    std::size_t actualLength = static_cast<std::size_t>(formatInteger(actual, value) - actual);
+    return expectedLength == actualLength && std::memcmp(expected, actual, actualLength) == 0;
+}
+
+bool checkFormatting(const std::vector<int>& values) {
+    bool ok = sameAsToChars(0) && sameAsToChars(INT_MIN) && sameAsToChars(INT_MAX) &&
+              sameAsToChars(std::numeric_limits<long long>::min()) &&
+              sameAsToChars(std::numeric_limits<long long>::max()) &&
+              sameAsToChars(std::numeric_limits<unsigned long long>::max()) &&
+              sameAsToChars(static_cast<unsigned long long>(UINT32_MAX) + 1);
+    for (long long power = 1; power < LLONG_MAX / 10; power *= 10) {
+        ok = ok && sameAsToChars(power - 1) && sameAsToChars(power) && sameAsToChars(-power);
+    }
+    for (int value : values) ok = ok && sameAsToChars(value);
+    return ok;
+}
+
+void report(const BenchResult& result) {
+    std::fprintf(stderr, "%-36s %8.1f ns/int %14.0f ints/s\n", result.name.c_str(), result.nsPerOp,
+                 1e9 / result.nsPerOp);
+}
+
+int main() {
+    const std::size_t iterations = 2000000;
+    const std::size_t mask = 4095;
+
+    // Roughly uniform digit counts: 1-digit values are as common as 10-digit ones
+    std::vector<int> values(mask + 1);
+    std::mt19937 random(42);
+    for (int& value : values) {
+        long long limit = 10;
+        for (unsigned digits = static_cast<unsigned>(random() % 10); digits > 0; --digits) limit *= 10;
+        long long magnitude = static_cast<long long>(random() % static_cast<unsigned long long>(limit));
+        if (magnitude > INT_MAX) magnitude = INT_MAX;
+        value = static_cast<int>(random() % 2 ? -magnitude : magnitude);
+    }
+
+    if (!checkFormatting(values)) {
+        std::fprintf(stderr, "formatInteger disagrees with std::to_chars\n");
+        return 1;
+    }
+
+    int devNull = ::open("/dev/null", O_WRONLY);
+    ::dup2(devNull, STDOUT_FILENO);
+
+    report(runBench("std::cout << v << std::endl", iterations / 10, [&](std::size_t i) {
+        std::cout << values[i & mask] << std::endl;
+    }));
+    report(runBench("std::cout << v << '\\n'", iterations, [&](std::size_t i) {
+        std::cout << values[i & mask] << '\n';
+    }));
+    std::cout.flush();
+    report(runBench("std::printf(\"%d\\n\")", iterations, [&](std::size_t i) {
+        std::printf("%d\n", values[i & mask]);
+    }));
+    std::fflush(stdout);
+#if defined(__cpp_lib_print)
+    report(runBench("std::println(\"{}\")", iterations, [&](std::size_t i) {
+        std::println("{}", values[i & mask]);
+    }));
+    std::fflush(stdout);
+#else
+    std::fprintf(stderr, "%-36s (no <print> in this standard library)\n", "std::println(\"{}\")");
+#endif
+    {
+        FormatBuffer out;
+        report(runBench("FormatBuffer (digit pairs)", iterations, [&](std::size_t i) {
+            out.append(values[i & mask]).append('\n');
+        }));
+    }
+    {
+        FormatBuffer out;
+        char digits[16];
+        report(runBench("FormatBuffer (std::to_chars)", iterations, [&](std::size_t i) {
+            char* end = std::to_chars(digits, digits + sizeof(digits), values[i & mask]).ptr;
+            *end++ = '\n';
+            out.append(digits, static_cast<std::size_t>(end - digits));
+        }));
+    }
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++23 -O2 -DNDEBUG format_bench.cpp -o format_bench
+./format_bench
+
+std::println needs a standard library with <print> (libc++ 17+, libstdc++ 14+)
+===============================================================================
+*/
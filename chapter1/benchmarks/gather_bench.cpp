@@ -0,0 +1,97 @@
+/*
+===============================================================================
+TITLE: Scalar foo_* loop vs SIMD bulk gather
+TOPIC: Per-element branching vs one validated pass
+
+Every case performs the same 1M lookups into a 4096-element array; about
+1% of the (base, off) pairs are out of bounds. Reported per element.
+
+CASES:
+1. foo_optional loop     - one call, one branch per lookup
+2. foo_exception loop    - same, plus a throw for each bad lookup
+3. gatherScalar          - branch-free scalar kernel
+4. gatherSse2 / Avx2     - SIMD compares (Avx2 also gathers in hardware)
+5. foo_optional_batch    - public batch API (widest kernel of the build)
+===============================================================================
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#define HW1_3_NO_MAIN
+#include "../HW1_3_solution.cpp"   // foo_* approaches, SafeArray and batch variants
+#include "bench.h"
+
+int main() {
+    const std::size_t lookups = 1 << 20;
+    const std::size_t rounds = 20;
+    std::vector<int> array(4096);
+    for (std::size_t i = 0; i < array.size(); ++i) array[i] = static_cast<int>(i * 3);
+
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> inside(0, 2047);
+    std::vector<int> bases(lookups), offs(lookups), out(lookups);
+    std::vector<std::uint64_t> mask(gatherMaskWords(lookups));
+    for (std::size_t i = 0; i < lookups; ++i) {
+        bases[i] = inside(rng);
+        offs[i] = (rng() % 100 == 0) ? 5000 : inside(rng);   // ~1% out of bounds
+    }
+
+    auto perElement = [&](BenchResult result) {
+        result.nsPerOp /= static_cast<double>(lookups);
+        result.iterations *= lookups;
+        printResult(result);
+    };
+
+    perElement(runBench("foo_optional loop", rounds, [&](std::size_t) {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            std::optional<int> value = foo_optional(array.data(), bases[i], offs[i], array.size());
+            out[i] = value ? *value : 0;
+        }
+        doNotOptimize(out[0]);
+    }));
+
+    perElement(runBench("foo_exception loop", rounds, [&](std::size_t) {
+        for (std::size_t i = 0; i < lookups; ++i) {
+            try {
+                out[i] = foo_exception(array.data(), bases[i], offs[i], array.size());
+            } catch (const std::out_of_range&) {
+                out[i] = 0;
+            }
+        }
+        doNotOptimize(out[0]);
+    }));
+
+    perElement(runBench("gatherScalar", rounds, [&](std::size_t) {
+        doNotOptimize(gatherScalar(array.data(), array.size(), bases.data(), offs.data(), out.data(), mask.data(), lookups));
+    }));
+
+#if defined(__SSE2__)
+    perElement(runBench("gatherSse2", rounds, [&](std::size_t) {
+        doNotOptimize(gatherSse2(array.data(), array.size(), bases.data(), offs.data(), out.data(), mask.data(), lookups));
+    }));
+#endif
+#if defined(__AVX2__)
+    perElement(runBench("gatherAvx2", rounds, [&](std::size_t) {
+        doNotOptimize(gatherAvx2(array.data(), array.size(), bases.data(), offs.data(), out.data(), mask.data(), lookups));
+    }));
+#endif
+
+    perElement(runBench("foo_optional_batch", rounds, [&](std::size_t) {
+        doNotOptimize(foo_optional_batch(array.data(), bases, offs, array.size(), out, mask));
+    }));
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++20 -O2 -DNDEBUG gather_bench.cpp -o gather_bench          # SSE2
+clang++ -std=c++20 -O2 -DNDEBUG -mavx2 gather_bench.cpp -o gather_bench   # + AVX2
+./gather_bench
+===============================================================================
+*/
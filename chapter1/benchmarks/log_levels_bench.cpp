@@ -0,0 +1,99 @@
+/*
+===============================================================================
+TITLE: Cost of disabled vs enabled log levels
+TOPIC: Compile-time threshold, runtime filter, enabled call
+
+CASES (StaticLogger<LogLevel::Info, CountingSink>):
+1. LOG_DEBUG         - below the compile-time threshold: compiled out
+2. LOG_INFO, filtered - runtime level raised to Warn: one relaxed load
+3. LOG_INFO, enabled  - formats into the counting sink
+
+Each case also reports how many times the sink was called and how many
+times the (deliberately expensive) argument was evaluated. Case 1 must show
+zero for both, otherwise the program exits with 1 (ctest runs it as
+log_levels_compiled_out).
+
+NO CALL SURVIVES, checked by the linker:
+- undefinedArgument() is declared but defined nowhere, and is passed to
+  LOG_TRACE and LOG_DEBUG below the threshold. A discarded `if constexpr`
+  branch may name a function without a definition; if the macro ever
+  emitted the call, the program would fail to LINK, at any -O level
+- To look at it yourself:
+    clang++ -std=c++17 -O2 -S log_levels_bench.cpp -o - | grep expensiveArgument
+  shows two calls: the LOG_INFO cases. The LOG_DEBUG case left nothing behind.
+
+USAGE:
+    ./log_levels_bench [iterations]
+===============================================================================
+*/
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "../log_levels.h"
+#include "bench.h"
+
+static std::size_t sinkCalls = 0;
+static std::size_t argumentEvaluations = 0;
+
+struct CountingSink {
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        char line[kLogLineText];
+        doNotOptimize(formatLogLine(line, format, args...));
+        ++sinkCalls;
+    }
+};
+
+__attribute__((noinline)) long expensiveArgument(std::size_t i) {
+    ++argumentEvaluations;
+    return static_cast<long>(i) * 31;
+}
+
+// Declared, never defined: only a compiled-out log line may name it
+long undefinedArgument(std::size_t i);
+
+template <typename F>
+void report(const char* name, std::size_t iterations, F&& body) {
+    sinkCalls = 0;
+    argumentEvaluations = 0;
+    BenchResult result = runBench(name, iterations, body);
+    printResult(result);
+    std::printf("    sink calls: %zu, argument evaluations: %zu\n", sinkCalls, argumentEvaluations);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    StaticLogger<LogLevel::Info, CountingSink> logger{CountingSink{}};
+
+    report("LOG_DEBUG (compiled out)", iterations, [&](std::size_t i) {
+        LOG_DEBUG(logger, "Value of featureEnabled: {}", expensiveArgument(i));
+        LOG_DEBUG(logger, "Never linked: {}", undefinedArgument(i));
+        LOG_TRACE(logger, "Never linked: {}", undefinedArgument(i));
+    });
+    if (sinkCalls != 0 || argumentEvaluations != 0) {
+        std::printf("FAILED: a compiled-out log line called the sink or evaluated its argument\n");
+        return 1;
+    }
+
+    logger.setLevel(LogLevel::Warn);
+    report("LOG_INFO (runtime filtered)", iterations, [&](std::size_t i) {
+        LOG_INFO(logger, "Value of featureEnabled: {}", expensiveArgument(i));
+    });
+
+    logger.setLevel(LogLevel::Info);
+    report("LOG_INFO (enabled)", iterations / 10, [&](std::size_t i) {
+        LOG_INFO(logger, "Value of featureEnabled: {}", expensiveArgument(i));
+    });
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 -DNDEBUG log_levels_bench.cpp -o log_levels_bench
+./log_levels_bench
+clang++ -std=c++17 -O0 log_levels_bench.cpp -o log_levels_bench   # links at -O0 too
+===============================================================================
+*/
@@ -0,0 +1,136 @@
+/*
+===============================================================================
+TITLE: Memory-mapped log vs ofstream vs batched write()
+TOPIC: Where does the time of a log line go with 1, 4 and 16 threads?
+
+SINKS (all write "[LOG] message\n" lines to a file):
+- ofstream : mutex + std::ofstream + std::endl, like the synchronous Logger
+- write()  : mutex + 64 KB buffer, one write() per full buffer
+- mmap     : MmapLogWriter - fetch_add reservation + memcpy, no lock
+
+Reported per sink and thread count: lines per second across all threads
+and p99 latency of a single call.
+
+USAGE:
+    ./mmap_log_bench [lines_per_thread]
+===============================================================================
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../mmap_log.h"
+#include "bench.h"
+
+class OfstreamSink {
+private:
+    std::mutex lock;
+    std::ofstream file;
+
+public:
+    explicit OfstreamSink(const char* path) : file(path) {}
+
+    void log(const char* message, std::size_t length) {
+        std::lock_guard<std::mutex> guard(lock);
+        file << "[LOG] ";
+        file.write(message, static_cast<std::streamsize>(length)) << std::endl;
+    }
+};
+
+class WriteBatchSink {
+private:
+    std::mutex lock;
+    int fd;
+    std::vector<char> buffer = std::vector<char>(64 * 1024);
+    std::size_t used = 0;
+
+    void flush() {
+        const char* data = buffer.data();
+        while (used > 0) {
+            ssize_t written = ::write(fd, data, used);
+            if (written <= 0) break;
+            data += written;
+            used -= static_cast<std::size_t>(written);
+        }
+        used = 0;
+    }
+
+public:
+    explicit WriteBatchSink(const char* path) : fd(::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) {}
+
+    void log(const char* message, std::size_t length) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (buffer.size() - used < length + 7) flush();
+        std::memcpy(buffer.data() + used, "[LOG] ", 6);
+        std::memcpy(buffer.data() + used + 6, message, length);
+        buffer[used + 6 + length] = '\n';
+        used += length + 7;
+    }
+
+    ~WriteBatchSink() {
+        flush();
+        ::close(fd);
+    }
+};
+
+struct MmapSink {
+    MmapLogWriter writer;
+
+    explicit MmapSink(const char* path) : writer(makeConfig(path)) {}
+
+    static MmapLogConfig makeConfig(const char* path) {
+        MmapLogConfig config;
+        config.path = path;
+        return config;
+    }
+
+    void log(const char* message, std::size_t length) { writer.append(message, length); }
+};
+
+template <typename Sink>
+void run(const char* name, const char* path, unsigned threads, std::size_t perThread) {
+    static const char message[] = "IF CONDITION: featureEnabled is TRUE - executing critical path";
+    StressResult stats;
+    {
+        Sink sink(path);
+        stats = stressThreads(threads, perThread, [&](unsigned) { sink.log(message, sizeof(message) - 1); });
+    }   // Includes nothing after the last line: flush/unmap happen here, untimed
+    std::printf("%-8u %-8s %16.0f %12.0f\n", threads, name, stats.opsPerSecond, stats.p99Nanoseconds);
+}
+
+int main(int argc, char** argv) {
+    std::size_t perThread = argc > 1 ? static_cast<std::size_t>(std::atol(argv[1])) : 100000;
+
+    std::printf("%-8s %-8s %16s %12s\n", "threads", "sink", "lines/s", "p99 ns");
+    for (unsigned threads : {1u, 4u, 16u}) {
+        run<OfstreamSink>("ofstream", "bench_ofstream_log.txt", threads, perThread);
+        run<WriteBatchSink>("write()", "bench_write_log.txt", threads, perThread);
+        run<MmapSink>("mmap", "bench_mmap_log.txt", threads, perThread);
+    }
+
+    std::remove("bench_ofstream_log.txt");
+    std::remove("bench_write_log.txt");
+    char segment[64];
+    for (unsigned index = 0;; ++index) {
+        std::snprintf(segment, sizeof(segment), "bench_mmap_log.txt.%03u", index);
+        if (std::remove(segment) != 0) break;
+    }
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 -DNDEBUG -pthread mmap_log_bench.cpp -o mmap_log_bench
+./mmap_log_bench 100000
+===============================================================================
+*/
@@ -0,0 +1,75 @@
+/*
+===============================================================================
+TITLE: print() overload benchmark
+TOPIC: Copies, allocations and per-element operator<<
+
+Reported per call: time and heap allocations. stdout goes to /dev/null so
+the numbers show formatting and copying, not the terminal.
+
+CASES:
+- old print(const std::vector<int> n)  by value: copies the vector
+- print(const std::vector<int>&)        no copy
+- print({1, 2, 3, 4})                   stack array; the old overload built a vector
+- per-element operator<< vs writeRange  for a 1000-int range
+===============================================================================
+*/
+
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../alloc_counter.h"
+#include "../print_overloads.h"
+#include "bench.h"
+
+// The overload as it was before: by value
+void printByValue(const std::vector<int> n) {
+    std::cout << "print(vector) <int>" << std::endl;
+    doNotOptimize(n.data());
+}
+
+template <typename F>
+void report(const char* name, std::size_t iterations, F&& body) {
+    std::size_t before = allocationCount();
+    BenchResult result = runBench(name, iterations, body);
+    double allocations = static_cast<double>(allocationCount() - before) /
+                         static_cast<double>(iterations + iterations / 10);
+    std::fprintf(stderr, "%-44s %12.1f ns/call %8.2f allocs/call\n", result.name.c_str(), result.nsPerOp,
+                 allocations);
+}
+
+int main() {
+    int devNull = ::open("/dev/null", O_WRONLY);
+    ::dup2(devNull, STDOUT_FILENO);                 // Report goes to stderr
+
+    const std::size_t iterations = 200000;
+    std::vector<int> small = {1, 2, 3, 4};
+    std::vector<int> large(1000);
+    std::iota(large.begin(), large.end(), -500);
+
+    report("old print(vector) by value, 4 ints", iterations, [&](std::size_t) { printByValue(small); });
+    report("old print({1, 2, 3, 4}) via vector", iterations, [&](std::size_t) { printByValue({1, 2, 3, 4}); });
+    report("print(const vector&), 4 ints", iterations, [&](std::size_t) { print(small); });
+    report("print({1, 2, 3, 4}) stack array", iterations, [&](std::size_t) { print({1, 2, 3, 4}); });
+
+    report("1000 ints, operator<< per element", iterations / 100, [&](std::size_t) {
+        std::cout << "print(vector) <int>:";
+        for (int value : large) std::cout << ' ' << value;
+        std::cout << '\n';
+    });
+    report("1000 ints, writeRange (one buffer)", iterations / 100, [&](std::size_t) { print(large); });
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++20 -O2 -DNDEBUG print_bench.cpp -o print_bench
+./print_bench
+===============================================================================
+*/
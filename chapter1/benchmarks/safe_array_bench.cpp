@@ -0,0 +1,83 @@
+/*
+===============================================================================
+TITLE: SafeArray check policies vs raw a[base + off]
+TOPIC: What each CheckPolicy costs on the happy path
+
+All indices are valid; each iteration sums 4096 lookups whose (base, off)
+pairs come from memory, so the compiler cannot prove them in bounds.
+Reported per lookup, in the style of Google Benchmark's per-item time.
+===============================================================================
+*/
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#define HW1_3_NO_MAIN
+#include "../HW1_3_solution.cpp"   // SafeArray and its check policies
+#include "bench.h"
+
+constexpr std::size_t kLookups = 4096;
+
+template <typename Policy>
+BenchResult measure(const char* name, std::vector<int>& array, const std::vector<int>& bases,
+                    const std::vector<int>& offs) {
+    SafeArray<int, Policy> safe{array.data(), array.size()};
+    BenchResult result = runBench(name, 2000, [&](std::size_t) {
+        long long sum = 0;
+        for (std::size_t i = 0; i < kLookups; ++i) {
+            if constexpr (std::is_same_v<Policy, OptionalOnError>) {
+                sum += *safe.get(bases[i], offs[i]);
+            }
+#if defined(__cpp_lib_expected)
+            else if constexpr (std::is_same_v<Policy, ExpectedOnError>) {
+                sum += *safe.get(bases[i], offs[i]);
+            }
+#endif
+            else {
+                sum += safe.get(bases[i], offs[i]);
+            }
+        }
+        doNotOptimize(sum);
+    });
+    result.nsPerOp /= kLookups;
+    return result;
+}
+
+int main() {
+    std::vector<int> array(1024);
+    for (std::size_t i = 0; i < array.size(); ++i) array[i] = static_cast<int>(i);
+
+    std::mt19937 rng(7);
+    std::vector<int> bases(kLookups), offs(kLookups);
+    for (std::size_t i = 0; i < kLookups; ++i) {
+        bases[i] = static_cast<int>(rng() % 512);
+        offs[i] = static_cast<int>(rng() % 512);
+    }
+
+    BenchResult raw = runBench("raw a[base + off]", 2000, [&](std::size_t) {
+        long long sum = 0;
+        for (std::size_t i = 0; i < kLookups; ++i) sum += array[bases[i] + offs[i]];
+        doNotOptimize(sum);
+    });
+    raw.nsPerOp /= kLookups;
+    printResult(raw);
+
+    printResult(measure<ThrowOnError>("SafeArray<int, ThrowOnError>", array, bases, offs));
+    printResult(measure<OptionalOnError>("SafeArray<int, OptionalOnError>", array, bases, offs));
+#if defined(__cpp_lib_expected)
+    printResult(measure<ExpectedOnError>("SafeArray<int, ExpectedOnError>", array, bases, offs));
+#endif
+    printResult(measure<AssertOnError>("SafeArray<int, AssertOnError>", array, bases, offs));
+    printResult(measure<Unchecked>("SafeArray<int, Unchecked>", array, bases, offs));
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++23 -O2 -DNDEBUG safe_array_bench.cpp -o safe_array_bench
+./safe_array_bench
+===============================================================================
+*/
@@ -0,0 +1,86 @@
+/*
+===============================================================================
+TITLE: Multi-threaded logging stress benchmark
+TOPIC: Sharded Logger vs one mutex-protected ofstream
+
+For 1, 2, 4, ... N threads (N = hardware_concurrency, or argv[1]) every
+thread logs the same number of messages as fast as it can. Reported:
+- messages per second across all threads
+- p99 latency of a single log() call
+- for the sharded logger, the time of the final merge
+
+USAGE:
+    ./sharded_log_bench [max_threads] [messages_per_thread]
+===============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../sharded_logger.h"
+#include "bench.h"
+
+// The "just add a mutex" alternative
+class MutexLogger {
+private:
+    std::mutex lock;
+    std::ofstream file;
+
+public:
+    explicit MutexLogger(const char* path) : file(path) {}
+
+    void log(const char* message) {
+        std::lock_guard<std::mutex> guard(lock);
+        file << "[LOG] " << message << '\n';
+    }
+};
+
+static const char kMessage[] = "IF CONDITION: featureEnabled is TRUE - executing critical path";
+
+int main(int argc, char** argv) {
+    unsigned maxThreads = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1]))
+                                   : std::max(1u, std::thread::hardware_concurrency());
+    std::size_t perThread = argc > 2 ? static_cast<std::size_t>(std::atol(argv[2])) : 200000;
+
+    // 1, 2, 4, ... and finally maxThreads itself
+    std::vector<unsigned> counts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) counts.push_back(threads);
+    counts.push_back(maxThreads);
+
+    std::printf("%-8s %-8s %16s %12s %12s\n", "threads", "logger", "msgs/s", "p99 ns", "merge ms");
+    for (unsigned threads : counts) {
+        {
+            MutexLogger logger("bench_mutex_log.txt");
+            StressResult stats = stressThreads(threads, perThread, [&](unsigned) { logger.log(kMessage); });
+            std::printf("%-8u %-8s %16.0f %12.0f %12s\n", threads, "mutex", stats.opsPerSecond,
+                        stats.p99Nanoseconds, "-");
+        }
+        {
+            ShardedLogger logger("bench_sharded_log.txt");
+            StressResult stats = stressThreads(threads, perThread, [&](unsigned) { logger.log(kMessage); });
+            auto mergeStart = std::chrono::steady_clock::now();
+            logger.merge();
+            double mergeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - mergeStart).count();
+            std::printf("%-8u %-8s %16.0f %12.0f %12.1f\n", threads, "sharded", stats.opsPerSecond,
+                        stats.p99Nanoseconds, mergeMs);
+        }
+    }
+    std::remove("bench_mutex_log.txt");
+    std::remove("bench_sharded_log.txt");
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 -DNDEBUG -pthread sharded_log_bench.cpp -o sharded_log_bench
+./sharded_log_bench 16
+===============================================================================
+*/
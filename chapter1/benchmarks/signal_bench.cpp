@@ -0,0 +1,214 @@
+/*
+===============================================================================
+TITLE: Cross-thread signaling under contention
+TOPIC: volatile spin vs atomic spin vs SignalFlag vs mutex + condvar
+
+Two threads play ping-pong: each waits for its flag, clears it and sets
+the other thread's flag. One round trip is two wake-ups.
+
+REPORTED:
+1. Wake-up latency: one pair, every round trip timed on its own,
+   median and p99 of half a round trip
+2. Throughput: 1, 2, 4, ... pairs at once (up to one thread per core, and
+   one step past it), total hand-offs per second across all pairs
+
+CHANNELS:
+- volatile spin : `volatile int flag; while (!flag) {}` - the misuse this
+                  replaces. It is a data race (ThreadSanitizer reports it)
+                  and orders no other data; it is here for the numbers only
+- atomic spin   : std::atomic<bool>, release store / acquire load, pause
+- SignalFlag    : bounded spin, then futex sleep (signal_flag.h)
+- condvar       : std::mutex + std::condition_variable + bool
+
+Pure spinning needs a core per spinning thread: with more threads than
+cores a spinner only gives up its core when the scheduler preempts it,
+which turns every hand-off into a time slice. Those rows are skipped.
+
+USAGE:
+    ./signal_bench [round_trips]
+===============================================================================
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "../signal_flag.h"
+
+struct alignas(64) VolatileChannel {
+    volatile int flag = 0;
+    void signal() { flag = 1; }
+    void wait() {
+        while (!flag) {}
+        flag = 0;
+    }
+};
+
+struct alignas(64) AtomicSpinChannel {
+    std::atomic<bool> flag{false};
+    void signal() { flag.store(true, std::memory_order_release); }
+    void wait() {
+        while (!flag.load(std::memory_order_acquire)) cpuRelax();
+        flag.store(false, std::memory_order_relaxed);
+    }
+};
+
+struct alignas(64) SignalFlagChannel {
+    SignalFlag flag;
+    void signal() { flag.set(); }
+    void wait() {
+        flag.wait();
+        flag.clear();
+    }
+};
+
+struct alignas(64) CondvarChannel {
+    std::mutex lock;
+    std::condition_variable changed;
+    bool flag = false;
+    void signal() {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            flag = true;
+        }
+        changed.notify_one();
+    }
+    void wait() {
+        std::unique_lock<std::mutex> guard(lock);
+        changed.wait(guard, [&] { return flag; });
+        flag = false;
+    }
+};
+
+template <typename Channel>
+struct Pair {
+    Channel ping;
+    Channel pong;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double nanoseconds(Clock::duration elapsed) { return std::chrono::duration<double, std::nano>(elapsed).count(); }
+
+// One pair; returns the time of every round trip in ns
+template <typename Channel>
+std::vector<double> roundTrips(std::size_t count) {
+    Pair<Channel> pair;
+    std::thread partner([&] {
+        for (std::size_t i = 0; i < count; ++i) {
+            pair.ping.wait();
+            pair.pong.signal();
+        }
+    });
+    std::vector<double> samples(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        Clock::time_point start = Clock::now();
+        pair.ping.signal();
+        pair.pong.wait();
+        samples[i] = nanoseconds(Clock::now() - start);
+    }
+    partner.join();
+    return samples;
+}
+
+// `pairs` independent pairs at once; returns hand-offs per second
+template <typename Channel>
+double handoffsPerSecond(unsigned pairs, std::size_t count) {
+    std::vector<std::unique_ptr<Pair<Channel>>> channels;
+    for (unsigned i = 0; i < pairs; ++i) channels.emplace_back(new Pair<Channel>);
+    std::vector<std::thread> threads;
+
+    Clock::time_point start = Clock::now();
+    for (unsigned i = 0; i < pairs; ++i) {
+        Pair<Channel>& pair = *channels[i];
+        threads.emplace_back([&pair, count] {
+            for (std::size_t n = 0; n < count; ++n) {
+                pair.ping.wait();
+                pair.pong.signal();
+            }
+        });
+        threads.emplace_back([&pair, count] {
+            for (std::size_t n = 0; n < count; ++n) {
+                pair.ping.signal();
+                pair.pong.wait();
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    double seconds = nanoseconds(Clock::now() - start) / 1e9;
+    return 2.0 * static_cast<double>(count) * pairs / seconds;
+}
+
+template <typename Channel>
+void latencyRow(const char* name, std::size_t count, bool runnable) {
+    if (!runnable) {
+        std::printf("%-16s %12s %12s   (spinning needs 2 free cores)\n", name, "skipped", "");
+        return;
+    }
+    std::vector<double> samples = roundTrips<Channel>(count);
+    std::sort(samples.begin(), samples.end());
+    // Half a round trip is one wake-up
+    std::printf("%-16s %9.0f ns %9.0f ns\n", name, samples[samples.size() / 2] / 2,
+                samples[samples.size() * 99 / 100] / 2);
+}
+
+template <typename Channel>
+void throughputRow(const char* name, const std::vector<unsigned>& pairCounts, std::size_t count, unsigned cores,
+                   bool spins) {
+    std::printf("%-16s", name);
+    for (unsigned pairs : pairCounts) {
+        if (spins && pairs * 2 > cores) {
+            std::printf(" %12s", "-");
+            continue;
+        }
+        std::printf(" %12.0f", handoffsPerSecond<Channel>(pairs, count));
+        std::fflush(stdout);
+    }
+    std::printf("\n");
+}
+
+int main(int argc, char** argv) {
+    std::size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000;
+    unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+    bool spinnable = cores >= 2;
+
+    std::printf("%u cores, %zu round trips per pair\n\n", cores, count);
+    std::printf("WAKE-UP LATENCY (one pair)\n");
+    std::printf("%-16s %12s %12s\n", "channel", "median", "p99");
+    latencyRow<VolatileChannel>("volatile spin", count, spinnable);
+    latencyRow<AtomicSpinChannel>("atomic spin", count, spinnable);
+    latencyRow<SignalFlagChannel>("SignalFlag", count, true);
+    latencyRow<CondvarChannel>("condvar", count, true);
+
+    // 1, 2, 4, ... pairs up to one thread per core, plus one oversubscribed step
+    std::vector<unsigned> pairCounts;
+    for (unsigned pairs = 1; pairs * 2 <= cores; pairs *= 2) pairCounts.push_back(pairs);
+    pairCounts.push_back(pairCounts.empty() ? 1 : pairCounts.back() * 2);
+
+    std::printf("\nTHROUGHPUT (hand-offs per second, all pairs together)\n");
+    std::printf("%-16s", "pairs");
+    for (unsigned pairs : pairCounts) std::printf(" %12u", pairs);
+    std::printf("\n");
+    throughputRow<VolatileChannel>("volatile spin", pairCounts, count, cores, true);
+    throughputRow<AtomicSpinChannel>("atomic spin", pairCounts, count, cores, true);
+    throughputRow<SignalFlagChannel>("SignalFlag", pairCounts, count, cores, false);
+    throughputRow<CondvarChannel>("condvar", pairCounts, count, cores, false);
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++20 -O2 -DNDEBUG -pthread signal_bench.cpp -o signal_bench
+./signal_bench
+taskset -c 0,1 ./signal_bench    # both threads of a pair on two chosen cores
+===============================================================================
+*/
@@ -0,0 +1,127 @@
+/*
+===============================================================================
+TITLE: Exec-to-exit latency of small programs
+TOPIC: What a launch costs before and after main()
+
+Every program given on the command line is started `runs` times with
+posix_spawn (stdout and stderr to /dev/null) and waited for. The time
+from spawn to the end of waitpid covers everything a launcher pays:
+exec, dynamic linking, static initializers (std::ios_base::Init), main,
+static destructors and exit. Programs run alternately, so a slow phase
+of the machine hits all of them alike.
+
+REPORTED per program: file size, min / median / p90 latency in
+microseconds, and the median relative to the first program.
+
+USAGE:
+    ./startup_bench [--runs 200] program [program ...]
+
+tools/startup_bench.sh builds the demos in the normal and the lean mode
+(see CMakeLists.txt, lean_out.h) and runs this on all of them.
+===============================================================================
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <spawn.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+
+struct Program {
+    std::string path;
+    long long bytes = 0;
+    std::vector<double> micros;
+    int failures = 0;
+};
+
+// One launch; returns microseconds, or -1 if the program could not run or failed
+double launch(const std::string& path, posix_spawn_file_actions_t& actions) {
+    char* argv[] = {const_cast<char*>(path.c_str()), nullptr};
+    auto start = std::chrono::steady_clock::now();
+    pid_t child;
+    if (::posix_spawn(&child, path.c_str(), &actions, nullptr, argv, environ) != 0) return -1;
+    int status = 0;
+    ::waitpid(child, &status, 0);
+    double micros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? micros : -1;
+}
+
+int main(int argc, char** argv) {
+    int runs = 200;
+    std::vector<Program> programs;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = std::max(1, std::atoi(argv[++i]));
+            continue;
+        }
+        Program program;
+        program.path = argv[i];
+        struct stat info;
+        if (::stat(argv[i], &info) != 0) {
+            std::fprintf(stderr, "%s: not found\n", argv[i]);
+            return 2;
+        }
+        program.bytes = static_cast<long long>(info.st_size);
+        programs.push_back(program);
+    }
+    if (programs.empty()) {
+        std::fprintf(stderr, "usage: %s [--runs 200] program [program ...]\n", argv[0]);
+        return 2;
+    }
+
+    posix_spawn_file_actions_t actions;
+    ::posix_spawn_file_actions_init(&actions);
+    ::posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    ::posix_spawn_file_actions_addopen(&actions, STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+
+    for (Program& program : programs) launch(program.path, actions);   // Page cache warm-up
+    for (int run = 0; run < runs; ++run) {
+        for (Program& program : programs) {
+            double micros = launch(program.path, actions);
+            if (micros < 0) ++program.failures;
+            else program.micros.push_back(micros);
+        }
+    }
+    ::posix_spawn_file_actions_destroy(&actions);
+
+    std::printf("%-44s %10s %9s %9s %9s %8s\n", "program", "bytes", "min us", "median", "p90", "vs 1st");
+    double reference = 0;
+    int status = 0;
+    for (Program& program : programs) {
+        if (program.micros.empty()) {
+            std::printf("%-44s %10lld   failed to run\n", program.path.c_str(), program.bytes);
+            status = 1;
+            continue;
+        }
+        std::sort(program.micros.begin(), program.micros.end());
+        double median = program.micros[program.micros.size() / 2];
+        double p90 = program.micros[program.micros.size() * 9 / 10];
+        if (reference == 0) reference = median;
+        std::printf("%-44s %10lld %9.0f %9.0f %9.0f %7.2fx", program.path.c_str(), program.bytes, program.micros[0],
+                    median, p90, median / reference);
+        if (program.failures > 0) std::printf("   (%d failed runs)", program.failures);
+        std::printf("\n");
+    }
+    return status;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 startup_bench.cpp -o startup_bench
+./startup_bench --runs 500 ./my_normal ./my_lean
+
+or let ../../tools/startup_bench.sh build and compare every demo.
+===============================================================================
+*/
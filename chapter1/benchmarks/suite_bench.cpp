@@ -0,0 +1,304 @@
+/*
+===============================================================================
+TITLE: Micro-benchmark suite for the chapter1 demo programs
+TOPIC: One number per hot operation, a JSON file, and a regression check
+
+CASES:
+- overload_test.cpp : print(int), print(const vector&), print({1, 2, 3, 4})
+                      and the old by-value print(vector) it replaced
+                      ("needs to construct vector object (more expensive)")
+- HW1_3             : the four approaches (foo_assert, foo_exception,
+                      foo_optional, SafeArray::get) plus foo_expected on
+                      valid runtime indices, pointer + size and fixed-size
+                      int[N] forms
+- Logger::log       : synchronous (ofstream + console), async ring, mmap;
+                      each in a temporary directory that is removed after
+                      the case, so no debug_log.txt lands in the tree
+- HW1_1             : volatile / const volatile nullptr_t -> pointer
+                      conversions next to a plain nullptr
+
+Each case is run `repeats` times and the fastest run is reported, which
+keeps scheduler noise out of the comparison. stdout is /dev/null while
+print() runs; the report goes to stdout afterwards.
+
+USAGE:
+    ./suite_bench                                   # table only
+    ./suite_bench --json baseline.json              # + Google Benchmark style JSON
+    ./suite_bench --baseline baseline.json          # exit 1 on a regression
+    ./suite_bench --baseline baseline.json --tolerance 0.25 --filter foo_
+
+BASELINES ARE PER MACHINE: nanoseconds from other hardware (or another VM
+size) say nothing about a change. Record the baseline with --json on the
+machine that runs the comparison, before the change; the JSON context
+holds the host name and CPU count, and --baseline refuses (exit 2) a file
+recorded elsewhere. No baseline is committed to the repository.
+===============================================================================
+*/
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define HW1_3_NO_MAIN
+#include "../HW1_3_solution.cpp"   // foo_* approaches, SafeArray and batch variants
+#include "../logger.h"
+#include "../print_overloads.h"
+#include "bench.h"
+
+struct SuiteOptions {
+    const char* json = nullptr;
+    const char* baseline = nullptr;
+    const char* filter = "";
+    double tolerance = 0.15;
+    int repeats = 5;
+};
+
+class Suite {
+private:
+    SuiteOptions options;
+    std::vector<BenchResult> results;
+
+public:
+    explicit Suite(const SuiteOptions& opts) : options(opts) {}
+
+    bool wants(const char* name) const { return std::strstr(name, options.filter) != nullptr; }
+
+    template <typename F>
+    void add(const char* name, std::size_t iterations, F&& body) {
+        if (!wants(name)) return;
+        BenchResult best = runBench(name, iterations, body);
+        for (int run = 1; run < options.repeats; ++run) {
+            BenchResult next = runBench(name, iterations, body);
+            if (next.nsPerOp < best.nsPerOp) best = next;
+        }
+        results.push_back(best);
+    }
+
+    const std::vector<BenchResult>& all() const { return results; }
+};
+
+// The overload overload_test.cpp started with, by value, but writing through
+// the same FormatBuffer as print(const vector&): the two cases differ only
+// in the copy, not in std::endl flushing
+void printByValue(const std::vector<int> n) {
+    writeRange("print(vector) <int>", n);
+}
+
+void printCases(Suite& suite) {
+    std::vector<int> small = {1, 2, 3, 4};
+    suite.add("print(int)", 200000, [&](std::size_t i) { print(static_cast<int>(i)); });
+    suite.add("print(const vector&), 4 ints", 200000, [&](std::size_t) { print(small); });
+    suite.add("print({1, 2, 3, 4}) stack array", 200000, [&](std::size_t) { print({1, 2, 3, 4}); });
+    suite.add("old print(vector) by value, 4 ints", 200000, [&](std::size_t) { printByValue(small); });
+}
+
+void boundsCases(Suite& suite) {
+    const std::size_t mask = 4095;
+    int fixed[1024];
+    for (int i = 0; i < 1024; ++i) fixed[i] = i;
+    int* a = fixed;
+    std::size_t size = 1024;
+
+    // Valid indices only: the happy path every call pays for
+    std::vector<int> bases(mask + 1);
+    std::vector<int> offs(mask + 1);
+    std::mt19937 rng(3);
+    for (std::size_t i = 0; i <= mask; ++i) {
+        bases[i] = static_cast<int>(rng() % 512);
+        offs[i] = static_cast<int>(rng() % 512);
+    }
+
+    const std::size_t iterations = 20000000;
+    suite.add("foo_assert (pointer, size)", iterations, [&](std::size_t i) {
+        doNotOptimize(foo_assert(a, bases[i & mask], offs[i & mask], size));
+    });
+    suite.add("foo_exception (pointer, size)", iterations, [&](std::size_t i) {
+        doNotOptimize(foo_exception(a, bases[i & mask], offs[i & mask], size));
+    });
+    suite.add("foo_optional (pointer, size)", iterations, [&](std::size_t i) {
+        doNotOptimize(*foo_optional(a, bases[i & mask], offs[i & mask], size));
+    });
+    suite.add("foo_exception (int[N])", iterations, [&](std::size_t i) {
+        doNotOptimize(foo_exception(fixed, bases[i & mask], offs[i & mask]));
+    });
+    suite.add("foo_optional (int[N])", iterations, [&](std::size_t i) {
+        doNotOptimize(*foo_optional(fixed, bases[i & mask], offs[i & mask]));
+    });
+    SafeArray safe{a, size};
+    SafeArray safeFixed{fixed};
+    suite.add("SafeArray::get (pointer, size)", iterations, [&](std::size_t i) {
+        doNotOptimize(safe.get(bases[i & mask], offs[i & mask]));
+    });
+    suite.add("SafeArray::get (int[N])", iterations, [&](std::size_t i) {
+        doNotOptimize(safeFixed.get(bases[i & mask], offs[i & mask]));
+    });
+#if defined(__cpp_lib_expected)
+    suite.add("foo_expected (pointer, size)", iterations, [&](std::size_t i) {
+        doNotOptimize(*foo_expected(a, bases[i & mask], offs[i & mask], size));
+    });
+    suite.add("foo_expected (int[N])", iterations, [&](std::size_t i) {
+        doNotOptimize(*foo_expected(fixed, bases[i & mask], offs[i & mask]));
+    });
+#endif
+}
+
+// The Loggers write debug_log.txt (and mmap segments of 16 MB each) into the
+// current directory: every case runs in its own temporary directory, which
+// is emptied and removed when the case is done
+class ScratchDirectory {
+private:
+    std::string path;
+    int previous = -1;
+
+public:
+    ScratchDirectory() {
+        const char* tmp = std::getenv("TMPDIR");
+        path = std::string(tmp != nullptr ? tmp : "/tmp") + "/suite_bench.XXXXXX";
+        previous = ::open(".", O_RDONLY | O_DIRECTORY);
+        if (::mkdtemp(&path[0]) == nullptr || ::chdir(path.c_str()) != 0) {
+            std::perror("suite_bench: scratch directory");
+            std::exit(2);
+        }
+    }
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    ~ScratchDirectory() {
+        if (DIR* dir = ::opendir(".")) {
+            while (dirent* entry = ::readdir(dir)) {
+                if (std::strcmp(entry->d_name, ".") != 0 && std::strcmp(entry->d_name, "..") != 0) {
+                    ::unlink(entry->d_name);
+                }
+            }
+            ::closedir(dir);
+        }
+        if (::fchdir(previous) != 0) std::perror("suite_bench: fchdir");
+        ::close(previous);
+        ::rmdir(path.c_str());
+    }
+};
+
+void loggerCases(Suite& suite) {
+    static const char message[] = "IF CONDITION: featureEnabled is TRUE - executing critical path";
+    const std::size_t length = sizeof(message) - 1;
+    if (suite.wants("Logger::log sync")) {
+        ScratchDirectory scratch;
+        Logger logger;   // debug_log.txt + console, std::endl on both
+        suite.add("Logger::log sync", 20000, [&](std::size_t) { logger.log(message, length); });
+    }
+    if (suite.wants("Logger::log async")) {
+        ScratchDirectory scratch;
+        AsyncLogConfig config;
+        config.overflow = OverflowPolicy::Block;
+        Logger logger(config);
+        suite.add("Logger::log async", 1000000, [&](std::size_t) { logger.log(message, length); });
+    }
+    if (suite.wants("Logger::log mmap")) {
+        ScratchDirectory scratch;
+        Logger logger(MmapLogConfig{});
+        suite.add("Logger::log mmap", 1000000, [&](std::size_t) { logger.log(message, length); });
+    }
+}
+
+void nullptrCases(Suite& suite) {
+    const std::size_t iterations = 50000000;
+    suite.add("HW1_1 nullptr -> int*", iterations, [&](std::size_t) {
+        int* b = nullptr;
+        doNotOptimize(b);
+    });
+    suite.add("HW1_1 volatile nullptr_t -> int*", iterations, [&](std::size_t) {
+        volatile std::nullptr_t a = nullptr;
+        int* b;
+        b = a;
+        doNotOptimize(b);
+    });
+    suite.add("HW1_1 const volatile nullptr_t -> double*", iterations, [&](std::size_t) {
+        const volatile std::nullptr_t c = nullptr;
+        double* d = c;
+        doNotOptimize(d);
+    });
+}
+
+int main(int argc, char** argv) {
+    SuiteOptions options;
+    for (int i = 1; i < argc; ++i) {
+        bool hasValue = i + 1 < argc;
+        if (std::strcmp(argv[i], "--json") == 0 && hasValue) options.json = argv[++i];
+        else if (std::strcmp(argv[i], "--baseline") == 0 && hasValue) options.baseline = argv[++i];
+        else if (std::strcmp(argv[i], "--tolerance") == 0 && hasValue) options.tolerance = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) options.filter = argv[++i];
+        else if (std::strcmp(argv[i], "--repeats") == 0 && hasValue) options.repeats = std::atoi(argv[++i]);
+        else {
+            std::fprintf(stderr, "usage: %s [--json out] [--baseline file] [--tolerance 0.15] "
+                                 "[--filter text] [--repeats 5]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    Suite suite(options);
+
+    // print() and the sync Logger write to stdout: send it to /dev/null meanwhile
+    std::fflush(stdout);
+    int savedStdout = ::dup(STDOUT_FILENO);
+    int devNull = ::open("/dev/null", O_WRONLY);
+    ::dup2(devNull, STDOUT_FILENO);
+    printCases(suite);
+    loggerCases(suite);
+    std::cout.flush();
+    std::fflush(stdout);
+    ::dup2(savedStdout, STDOUT_FILENO);
+
+    boundsCases(suite);
+    nullptrCases(suite);
+
+    for (const BenchResult& result : suite.all()) printResult(result);
+
+    if (options.json != nullptr && !writeJson(options.json, suite.all())) {
+        std::fprintf(stderr, "cannot write %s\n", options.json);
+        return 2;
+    }
+    if (options.baseline != nullptr) {
+        std::vector<BenchResult> baseline = readJson(options.baseline);
+        if (baseline.empty()) {
+            std::fprintf(stderr, "no results in baseline %s\n", options.baseline);
+            return 2;
+        }
+        BenchContext recorded = readJsonContext(options.baseline);
+        BenchContext here = currentContext();
+        if (!sameMachine(recorded, here)) {
+            std::fprintf(stderr, "%s was recorded on '%s' (%u cpus), this is '%s' (%u cpus): "
+                                 "record a baseline here with --json first\n",
+                         options.baseline, recorded.hostName.c_str(), recorded.cpus, here.hostName.c_str(), here.cpus);
+            return 2;
+        }
+        int regressions = compareToBaseline(suite.all(), baseline, options.tolerance);
+        std::printf("%d regression%s (tolerance %.0f%%)\n", regressions, regressions == 1 ? "" : "s",
+                    options.tolerance * 100.0);
+        return regressions == 0 ? 0 : 1;
+    }
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+cmake -S . -B build && cmake --build build     # from chapter1, C++23
+./build/suite_bench --json build/baseline.json       # before the change
+# ... change, rebuild ...
+./build/suite_bench --baseline build/baseline.json   # same machine, after
+
+or directly:
+clang++ -std=c++23 -O2 -DNDEBUG -pthread suite_bench.cpp -o suite_bench
+===============================================================================
+*/
@@ -0,0 +1,73 @@
+/*
+===============================================================================
+TITLE: Type-name lookup cost
+TOPIC: typeid().name() + __cxa_demangle per call vs cache vs constexpr
+
+CASES (a readable name per call, as a diagnostics path needs it):
+1. typeid(x).name() + demangle  - parse + malloc + free on every call
+2. typeid(x).name() only        - cheap, but mangled ("M9TestClassFvvE")
+3. demangledName(typeid(x))     - DemangleCache: demangled once per type
+4. typeName<T>()                - constexpr, the name is a literal
+
+Cases 1-3 use the dynamic type of a polymorphic object (one of several
+derived classes), where typeid must really look at the object.
+===============================================================================
+*/
+
+#include <cstdio>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#include "../type_name.h"
+#include "bench.h"
+
+struct Shape {
+    virtual ~Shape() = default;
+};
+struct Circle : Shape {};
+struct Square : Shape {};
+template <typename T>
+struct Tagged : Shape {};
+
+int main() {
+    Circle circle;
+    Square square;
+    Tagged<std::vector<int>> tagged;
+    Shape* shapes[] = {&circle, &square, &tagged};
+    const std::size_t iterations = 2000000;
+
+    std::printf("typeid(Tagged<std::vector<int>>).name() = %s\n", typeid(tagged).name());
+    std::printf("demangledName                           = %s\n",
+                std::string(demangledName(typeid(tagged))).c_str());
+    std::printf("typeName<Tagged<std::vector<int>>>()    = %s\n\n",
+                std::string(typeName<Tagged<std::vector<int>>>()).c_str());
+
+    printResult(runBench("typeid().name() + demangle each call", iterations / 10, [&](std::size_t i) {
+        std::string name = demangle(typeid(*shapes[i % 3]).name());
+        doNotOptimize(name.data());
+    }));
+    printResult(runBench("typeid().name() (mangled)", iterations, [&](std::size_t i) {
+        const char* name = typeid(*shapes[i % 3]).name();
+        doNotOptimize(name);
+    }));
+    printResult(runBench("demangledName(typeid()) cached", iterations, [&](std::size_t i) {
+        std::string_view name = demangledName(typeid(*shapes[i % 3]));
+        doNotOptimize(name.data());
+    }));
+    printResult(runBench("typeName<T>() constexpr", iterations, [&](std::size_t) {
+        std::string_view name = typeName<Tagged<std::vector<int>>>();
+        doNotOptimize(name.data());
+    }));
+    std::printf("\ncache entries: %zu\n", DemangleCache::instance().size());
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 -DNDEBUG type_name_bench.cpp -o type_name_bench
+./type_name_bench
+===============================================================================
+*/
@@ -0,0 +1,88 @@
+/*
+===============================================================================
+TITLE: Cost of -DUNINIT_CHECK on the hot path
+TOPIC: Is the shadow tag cheap enough for canary builds?
+
+CASES (per call of a processCriticalData-shaped function):
+1. plain int, initialized       - what the release build runs
+2. Tracked<int>, initialized    - declaration + two checked reads
+3. Tracked<int>, uninitialized  - the bug: every call takes the slow path
+                                  (only the first one is logged)
+
+Plus a read-only loop over 1024 values, plain vs Tracked, to isolate the
+per-read cost of the shadow compare.
+===============================================================================
+*/
+
+#define UNINIT_CHECK
+#define UNINIT_CHECK_HEAP_POISON   // The program's only translation unit
+#include "../uninit_check.h"
+
+#include <cstdio>
+
+#include "bench.h"
+
+__attribute__((noinline)) int releaseShape(int flag) {
+    int featureEnabled = flag;
+    return featureEnabled ? 3 : 5;
+}
+
+__attribute__((noinline)) int trackedShape(int flag) {
+    TRACKED_VAR_INIT(int, featureEnabled, flag);
+    doNotOptimize(TRACKED_READ(featureEnabled));
+    return TRACKED_READ(featureEnabled) ? 3 : 5;
+}
+
+__attribute__((noinline)) int buggyShape() {
+    TRACKED_VAR(int, featureEnabled);
+    doNotOptimize(TRACKED_READ(featureEnabled));
+    return TRACKED_READ(featureEnabled) ? 3 : 5;
+}
+
+int main() {
+    const std::size_t iterations = 20000000;
+    Logger logger;
+    UninitMonitor::attach(logger);               // The one buggy event lands in debug_log.txt
+
+    printResult(runBench("plain int, initialized", iterations, [&](std::size_t i) {
+        doNotOptimize(releaseShape(static_cast<int>(i & 1)));
+    }));
+    printResult(runBench("Tracked<int>, initialized", iterations, [&](std::size_t i) {
+        doNotOptimize(trackedShape(static_cast<int>(i & 1)));
+    }));
+    printResult(runBench("Tracked<int>, uninitialized (slow path)", iterations, [&](std::size_t) {
+        doNotOptimize(buggyShape());
+    }));
+    std::printf("    uninitialized reads counted: %zu\n", uninitReadCount());
+
+    static const UninitSite site{"values", "main", __LINE__};
+    int plain[1024];
+    Tracked<int>* tracked = static_cast<Tracked<int>*>(::operator new(sizeof(Tracked<int>) * 1024));
+    for (int i = 0; i < 1024; ++i) {
+        plain[i] = i;
+        new (&tracked[i]) Tracked<int>(site, i);
+    }
+    printResult(runBench("1024 reads, plain int", iterations / 1000, [&](std::size_t) {
+        long sum = 0;
+        for (int i = 0; i < 1024; ++i) sum += plain[i];
+        doNotOptimize(sum);
+    }));
+    printResult(runBench("1024 reads, Tracked<int>", iterations / 1000, [&](std::size_t) {
+        long sum = 0;
+        for (int i = 0; i < 1024; ++i) sum += tracked[i].read(__LINE__);
+        doNotOptimize(sum);
+    }));
+    ::operator delete(tracked);
+
+    UninitMonitor::detach();
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++17 -O2 -DNDEBUG uninit_bench.cpp -o uninit_bench
+./uninit_bench
+===============================================================================
+*/
@@ -0,0 +1,311 @@
+/*
+===============================================================================
+TITLE: Binary structured log format (deferred formatting)
+TOPIC: Move string formatting out of the hot path
+
+THE PROBLEM:
+    logger.log("Value of featureEnabled: " + std::to_string(featureEnabled));
+- std::to_string allocates, operator+ allocates again, then the text is copied
+  into the stream - all of this on every call, even if nobody reads the log
+
+THE IDEA:
+- Each call site registers its format string ONCE (function-local static)
+  and gets a small integer id
+- At run time only the id and the raw argument bytes are appended to a
+  fixed buffer, which is flushed to debug_log.bin with write()
+- log_decode.cpp turns the file back into the familiar "[LOG] ..." text
+
+FILE LAYOUT (host byte order):
+    "MIPTLOG1"                                   8-byte magic, = PROGRAM START
+    'F' u16 id  u16 length  bytes[length]        Format definition (first use only)
+    'E' u16 id  u8 argc  { u8 tag  payload }*    Event; tags below
+    'Z'                                          = PROGRAM END
+
+    tag 'i': int64    tag 'u': uint64    tag 'd': double
+    tag 's': u16 length + bytes (truncated to kMaxStringArg)
+===============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+constexpr char kBinaryLogMagic[8] = {'M', 'I', 'P', 'T', 'L', 'O', 'G', '1'};
+constexpr std::size_t kMaxStringArg = 1024;
+
+/*
+===============================================================================
+FORMAT REGISTRY - ids are handed out once per call site
+===============================================================================
+*/
+
+class LogFormatRegistry {
+private:
+    std::mutex lock;
+    std::vector<const char*> formats;
+
+    LogFormatRegistry() { formats.push_back("{}"); }   // id 0: plain log(text)
+
+public:
+    static LogFormatRegistry& instance() {
+        static LogFormatRegistry registry;
+        return registry;
+    }
+
+    std::uint16_t add(const char* text) {
+        std::lock_guard<std::mutex> guard(lock);
+        formats.push_back(text);
+        return static_cast<std::uint16_t>(formats.size() - 1);
+    }
+
+    const char* text(std::uint16_t id) {
+        std::lock_guard<std::mutex> guard(lock);
+        return formats[id];
+    }
+};
+
+struct LogFormat {
+    const char* text;
+    std::uint16_t id;
+
+    explicit LogFormat(const char* format)
+        : text(format), id(LogFormatRegistry::instance().add(format)) {}
+
+    // Built-in formats that the registry reserved up front
+    LogFormat(const char* format, std::uint16_t builtinId) : text(format), id(builtinId) {}
+};
+
+// Registers the format on first execution, then only forwards the arguments
+#define LOG_FMT(logger, format, ...)                                   \
+    do {                                                               \
+        static const LogFormat logFormat_(format);                     \
+        (logger).logf(logFormat_, ##__VA_ARGS__);                      \
+    } while (0)
+
+/*
+===============================================================================
+TEXT FORMATTING - Shared by the text Logger path and the decoder
+===============================================================================
+Each "{}" in the format is replaced by the next argument, exactly as
+std::to_string would print it. Fields without an argument stay "{}" and
+arguments without a field are dropped.
+
+The text paths format into a kLogLineText stack buffer: room for one
+string argument of the binary cap (kMaxStringArg) plus the format text.
+A line that does not fit is cut and ends in "..." so the cut is visible.
+===============================================================================
+*/
+
+constexpr std::size_t kLogLineText = 2 * kMaxStringArg;
+
+struct LogLineBuilder {
+    char* out;
+    std::size_t capacity;
+    std::size_t length = 0;
+    bool cut = false;
+
+    void append(const char* text, std::size_t size) {
+        if (size > capacity - length) {
+            size = capacity - length;
+            cut = true;
+        }
+        std::memcpy(out + length, text, size);
+        length += size;
+    }
+
+    void appendArg(unsigned long long value) {
+        char digits[24];
+        char* first = digits + sizeof(digits);
+        do {
+            *--first = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value != 0);
+        append(first, static_cast<std::size_t>(digits + sizeof(digits) - first));
+    }
+    void appendArg(long long value) {
+        if (value < 0) {
+            append("-", 1);
+            appendArg(0ull - static_cast<unsigned long long>(value));
+        } else {
+            appendArg(static_cast<unsigned long long>(value));
+        }
+    }
+    void appendArg(double value) {
+        char digits[64];
+        std::size_t size = static_cast<std::size_t>(std::snprintf(digits, sizeof(digits), "%f", value));
+        append(digits, size < sizeof(digits) ? size : sizeof(digits) - 1);
+    }
+    void appendArg(const char* text) { append(text, std::strlen(text)); }
+    void appendArg(const std::string& text) { append(text.data(), text.size()); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type appendArg(T value) {
+        if (std::is_signed<T>::value) appendArg(static_cast<long long>(value));
+        else appendArg(static_cast<unsigned long long>(value));
+    }
+    void appendArg(float value) { appendArg(static_cast<double>(value)); }
+
+    // Copies format text up to the next "{}"; returns false when the format is exhausted
+    bool nextField(const char*& format) {
+        const char* field = std::strstr(format, "{}");
+        if (!field) {
+            append(format, std::strlen(format));
+            format += std::strlen(format);
+            return false;
+        }
+        append(format, static_cast<std::size_t>(field - format));
+        format = field + 2;
+        return true;
+    }
+
+    // No arguments left: the rest of the format is copied as is, "{}" included
+    void format(const char*& format) {
+        while (nextField(format)) append("{}", 2);
+        if (cut && capacity >= 3) std::memcpy(out + capacity - 3, "...", 3);
+    }
+
+    template <typename T, typename... Rest>
+    void format(const char*& format, const T& first, const Rest&... rest) {
+        if (nextField(format)) appendArg(first);
+        this->format(format, rest...);
+    }
+};
+
+/*
+===============================================================================
+BINARY WRITER - Fixed buffer, no allocation, one write() per buffer
+===============================================================================
+*/
+
+struct BinaryLogConfig {
+    const char* path = "debug_log.bin";
+    std::size_t bufferBytes = 64 * 1024;
+};
+
+class BinaryLogWriter {
+private:
+    std::vector<char> buffer;           // Sized once in the constructor
+    std::size_t used = 0;
+    std::vector<bool> defined;          // Format ids already written to this file
+    int fd;
+
+    void put(const void* data, std::size_t size) {
+        std::memcpy(buffer.data() + used, data, size);
+        used += size;
+    }
+    template <typename T>
+    void put(T value) { put(&value, sizeof(value)); }
+
+    // Encoded size of each argument kind, so the space check happens once per record
+    static std::size_t encodedSize(const char* text) { return 3 + std::min(std::strlen(text), kMaxStringArg); }
+    static std::size_t encodedSize(const std::string& text) { return 3 + std::min(text.size(), kMaxStringArg); }
+    template <typename T>
+    static typename std::enable_if<std::is_arithmetic<T>::value, std::size_t>::type
+    encodedSize(T) { return 9; }
+
+    void encode(const char* text, std::size_t size) {
+        std::uint16_t length = static_cast<std::uint16_t>(std::min(size, kMaxStringArg));
+        put('s');
+        put(length);
+        put(text, length);
+    }
+    void encode(const char* text) { encode(text, std::strlen(text)); }
+    void encode(const std::string& text) { encode(text.data(), text.size()); }
+    void encode(double value) { put('d'); put(value); }
+    void encode(float value) { encode(static_cast<double>(value)); }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value>::type encode(T value) {
+        if (std::is_signed<T>::value) {
+            put('i');
+            put(static_cast<std::int64_t>(value));
+        } else {
+            put('u');
+            put(static_cast<std::uint64_t>(value));
+        }
+    }
+
+    void define(const LogFormat& format) {
+        std::uint16_t length = static_cast<std::uint16_t>(std::strlen(format.text));
+        reserve(5 + length);
+        put('F');
+        put(format.id);
+        put(length);
+        put(format.text, length);
+        defined[format.id] = true;
+    }
+
+    void reserve(std::size_t size) {
+        if (buffer.size() - used < size) flush();
+        if (buffer.size() < size) buffer.resize(size);   // Only for oversized formats
+    }
+
+public:
+    explicit BinaryLogWriter(const BinaryLogConfig& config)
+        : buffer(config.bufferBytes),
+          fd(::open(config.path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+        put(kBinaryLogMagic, sizeof(kBinaryLogMagic));
+    }
+
+    BinaryLogWriter(const BinaryLogWriter&) = delete;
+    BinaryLogWriter& operator=(const BinaryLogWriter&) = delete;
+
+    template <typename... Args>
+    void append(const LogFormat& format, const Args&... args) {
+        if (format.id >= defined.size()) defined.resize(format.id + 1u, false);
+        if (!defined[format.id]) define(format);
+
+        std::size_t sizes[] = {std::size_t(4), encodedSize(args)...};
+        std::size_t total = 0;
+        for (std::size_t size : sizes) total += size;
+        reserve(total);
+
+        put('E');
+        put(format.id);
+        put(static_cast<std::uint8_t>(sizeof...(Args)));
+        int expand[] = {0, (encode(args), 0)...};
+        (void)expand;
+    }
+
+    // Plain log(text) is recorded against the reserved "{}" format
+    void appendText(const char* text, std::size_t size) {
+        static const LogFormat plain("{}", 0);      // Not registered again: id 0 is built in
+        if (defined.empty()) defined.resize(1, false);
+        if (!defined[0]) define(plain);
+        reserve(4 + 3 + std::min(size, kMaxStringArg));
+        put('E');
+        put(std::uint16_t(0));
+        put(std::uint8_t(1));
+        encode(text, size);
+    }
+
+    void flush() {
+        const char* data = buffer.data();
+        std::size_t size = used;
+        while (size > 0) {
+            ssize_t written = ::write(fd, data, size);
+            if (written <= 0) break;
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+        used = 0;
+    }
+
+    ~BinaryLogWriter() {
+        reserve(1);
+        put('Z');
+        flush();
+        if (fd >= 0) ::close(fd);
+    }
+};
@@ -0,0 +1,34 @@
+/*
+===============================================================================
+TITLE: The critical path of processCriticalData
+TOPIC: One body for the demo, the batch pipeline and the benchmarks
+
+    if (runCriticalPath(logger, featureEnabled, onProcess, onSkip)) ...
+
+- The caller reads featureEnabled (uninitialized in the buggy demo) and
+  passes the value in; the branch and its log events live only here
+- onProcess runs between "executing critical path" and "completed",
+  onSkip between "skipping critical path" and the warning
+- debug_vs_release_bug.cpp prints to the console in them, batch_pipeline.h
+  processes one CriticalRecord, so every caller logs the same events
+- Returns whether the critical path was taken
+===============================================================================
+*/
+
+#pragma once
+
+#include "log_levels.h"
+
+template <typename CriticalLogger, typename OnProcess, typename OnSkip>
+bool runCriticalPath(CriticalLogger& logger, int featureEnabled, OnProcess&& onProcess, OnSkip&& onSkip) {
+    if (featureEnabled) {
+        LOG_INFO(logger, "IF CONDITION: featureEnabled is TRUE - executing critical path");
+        onProcess();
+        LOG_INFO(logger, "Critical processing completed successfully");
+        return true;
+    }
+    LOG_INFO(logger, "IF CONDITION: featureEnabled is FALSE - skipping critical path");
+    onSkip();
+    LOG_WARN(logger, "WARNING: Critical processing was skipped!");
+    return false;
+}
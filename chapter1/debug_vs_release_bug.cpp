@@ -15,30 +15,30 @@ KEY INSIGHT:
 ===============================================================================
 */
 
-#include <iostream>
-#include <fstream>
 #include <string>
-#include <chrono>
-
-// Simulate logging functionality for instrumentation
-class Logger {
-private:
-    std::ofstream logFile;
-public:
-    Logger() : logFile("debug_log.txt") {
-        logFile << "=== PROGRAM START ===" << std::endl;
-    }
-    
-    void log(const std::string& message) {
-        auto now = std::chrono::system_clock::now();
-        logFile << "[LOG] " << message << std::endl;
-        std::cout << "[LOG] " << message << std::endl; // Also output to console
-    }
-    
-    ~Logger() {
-        logFile << "=== PROGRAM END ===" << std::endl;
-    }
-};
+
+#include "logger.h"       // Logger: synchronous by default, async or binary mode on request
+#include "log_levels.h"   // StaticLogger: compile-time level threshold + static sinks
+#include "critical_path.h" // runCriticalPath: the branch and log events shared with batch_pipeline.h
+#define UNINIT_CHECK_HEAP_POISON // This file holds main: poisoned operator new with -DUNINIT_CHECK
+#include "uninit_check.h" // TRACKED_VAR: uninitialized-read detection with -DUNINIT_CHECK
+#include "trace_scope.h"  // TRACE_SCOPE: enter/exit tracing, Chrome trace JSON
+
+#ifdef LEAN_OUTPUT
+#include "lean_out.h"   // io::cout without <iostream> (lean build, see CMakeLists.txt)
+namespace io = lean;
+#else
+#include <iostream>
+namespace io = std;
+#endif
+
+// Lines below this level are compiled out, arguments included.
+// Build with -DLOG_MIN_LEVEL=LogLevel::Info to drop the Debug lines.
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL LogLevel::Debug
+#endif
+
+using DemoLogger = StaticLogger<LOG_MIN_LEVEL, LoggerSink>;
 
 /*
 ===============================================================================
@@ -58,32 +58,25 @@ In the original bug:
 ===============================================================================
 */
 
-void processCriticalData(Logger& logger) {
-    logger.log("Entering processCriticalData()");
+void processCriticalData(DemoLogger& logger) {
+    TRACE_SCOPE("processCriticalData"); // Enter/exit timestamps, exported to trace.json
     
     // THE BUG: Uninitialized variable - this is the core issue!
-    int featureEnabled; // NEVER INITIALIZED - contains garbage in release mode
+    TRACKED_VAR(int, featureEnabled); // NEVER INITIALIZED - contains garbage in release mode
     
-    logger.log("Variable 'featureEnabled' declared but not initialized");
-    logger.log("Value of featureEnabled: " + std::to_string(featureEnabled));
+    LOG_DEBUG(logger, "Variable 'featureEnabled' declared but not initialized");
+    LOG_DEBUG(logger, "Value of featureEnabled: {}", TRACKED_READ(featureEnabled));
     
     // Critical business logic that depends on this variable
-    if (featureEnabled) { // This is where the bug manifests!
-        logger.log("IF CONDITION: featureEnabled is TRUE - executing critical path");
-        
-        // Important processing that should happen
-        std::cout << "Processing critical data..." << std::endl;
-        logger.log("Critical processing completed successfully");
-        
-    } else {
-        logger.log("IF CONDITION: featureEnabled is FALSE - skipping critical path");
-        
-        // The bug: this path should NOT be taken in production
-        std::cout << "Skipping critical processing - FEATURE DISABLED" << std::endl;
-        logger.log("WARNING: Critical processing was skipped!");
-    }
-    
-    logger.log("Exiting processCriticalData()");
+    runCriticalPath(logger, TRACKED_READ(featureEnabled), // This is where the bug manifests!
+        [] {
+            // Important processing that should happen
+            io::cout << "Processing critical data..." << io::endl;
+        },
+        [] {
+            // The bug: this path should NOT be taken in production
+            io::cout << "Skipping critical processing - FEATURE DISABLED" << io::endl;
+        });
 }
 
 /*
@@ -92,59 +85,84 @@ THE FIXED VERSION - Shows how the bug should be fixed
 ===============================================================================
 */
 
-void processCriticalData_FIXED(Logger& logger) {
-    logger.log("Entering processCriticalData_FIXED()");
+void processCriticalData_FIXED(DemoLogger& logger) {
+    TRACE_SCOPE("processCriticalData_FIXED"); // Enter/exit timestamps, exported to trace.json
     
     // THE FIX: Proper initialization
-    int featureEnabled = 1; // Explicitly initialized - no more undefined behavior
+    TRACKED_VAR_INIT(int, featureEnabled, 1); // Explicitly initialized - no more undefined behavior
     
-    logger.log("Variable 'featureEnabled' properly initialized to: " + std::to_string(featureEnabled));
+    LOG_DEBUG(logger, "Variable 'featureEnabled' properly initialized to: {}", TRACKED_READ(featureEnabled));
     
     // Same critical logic but now predictable
-    if (featureEnabled) {
-        logger.log("IF CONDITION: featureEnabled is TRUE - executing critical path");
-        
-        std::cout << "Processing critical data..." << std::endl;
-        logger.log("Critical processing completed successfully");
-        
-    } else {
-        logger.log("IF CONDITION: featureEnabled is FALSE - skipping critical path");
-        
-        std::cout << "Skipping critical processing - FEATURE DISABLED" << std::endl;
-        logger.log("WARNING: Critical processing was skipped!");
-    }
-    
-    logger.log("Exiting processCriticalData_FIXED()");
+    runCriticalPath(logger, TRACKED_READ(featureEnabled),
+        [] { io::cout << "Processing critical data..." << io::endl; },
+        [] { io::cout << "Skipping critical processing - FEATURE DISABLED" << io::endl; });
 }
 
 int main() {
-    Logger logger;
-    
-    std::cout << "\n=== DEBUG VS RELEASE BUG DEMONSTRATION ===" << std::endl;
-    std::cout << "Replicating an 11+ year old bug pattern\n" << std::endl;
-    
-    logger.log("Starting debug vs release bug demonstration");
+#ifdef ASYNC_LOG
+    // Producers only copy into the ring; a background thread batches write() calls
+    AsyncLogConfig config;
+    config.overflow = OverflowPolicy::Block;   // A bug report must not lose lines
+    Logger backend(config);
+#elif defined(BINARY_LOG)
+    // Only format ids and raw arguments go to debug_log.bin; decode with log_decode
+    Logger backend(BinaryLogConfig{});
+#elif defined(MMAP_LOG)
+    // Lines are memcpy'd into mapped segments debug_log.txt.000, .001, ...
+    Logger backend(MmapLogConfig{});
+#else
+    Logger backend;
+#endif
+    DemoLogger logger{LoggerSink{backend}};
+    UninitMonitor::attach(backend);   // No-op unless built with -DUNINIT_CHECK
+    
+    io::cout << "\n=== DEBUG VS RELEASE BUG DEMONSTRATION ===" << io::endl;
+    io::cout << "Replicating an 11+ year old bug pattern\n" << io::endl;
+    
+    LOG_INFO(logger, "Starting debug vs release bug demonstration");
     
     // Part 1: Show the buggy behavior
-    std::cout << "\n--- PART 1: BUGGY VERSION ---" << std::endl;
-    logger.log("=== RUNNING BUGGY VERSION ===");
+    io::cout << "\n--- PART 1: BUGGY VERSION ---" << io::endl;
+    LOG_INFO(logger, "=== RUNNING BUGGY VERSION ===");
+    std::size_t uninitBefore = uninitReadCount();
     processCriticalData(logger);
+    std::size_t uninitBuggy = uninitReadCount() - uninitBefore;
     
     // Part 2: Show the fixed behavior  
-    std::cout << "\n--- PART 2: FIXED VERSION ---" << std::endl;
-    logger.log("=== RUNNING FIXED VERSION ===");
+    io::cout << "\n--- PART 2: FIXED VERSION ---" << io::endl;
+    LOG_INFO(logger, "=== RUNNING FIXED VERSION ===");
+    uninitBefore = uninitReadCount();
     processCriticalData_FIXED(logger);
-    
-    std::cout << "\n=== SUMMARY ===" << std::endl;
-    std::cout << "This demonstrates why uninitialized variables cause" << std::endl;
-    std::cout << "different behavior in debug vs release builds." << std::endl;
-    std::cout << "\nKey lessons:" << std::endl;
-    std::cout << "1. Always initialize variables" << std::endl;
-    std::cout << "2. Use compiler warnings (-Wall -Wextra)" << std::endl;
-    std::cout << "3. Test in both debug and release configurations" << std::endl;
-    std::cout << "4. Use instrumentation to track down mysterious bugs" << std::endl;
-    
-    logger.log("Bug demonstration completed");
+    std::size_t uninitFixed = uninitReadCount() - uninitBefore;
+
+#ifdef UNINIT_CHECK
+    // The detector must flag the buggy version and stay silent on the fixed one
+    io::cout << "\n--- UNINIT_CHECK ---" << io::endl;
+    io::cout << "Uninitialized reads: buggy = " << uninitBuggy << ", fixed = " << uninitFixed << io::endl;
+    if (uninitBuggy == 0 || uninitFixed != 0) {
+        io::cout << "UNINIT_CHECK validation FAILED" << io::endl;
+        return 1;
+    }
+#else
+    (void)uninitBuggy;
+    (void)uninitFixed;
+#endif
+    
+    io::cout << "\n=== SUMMARY ===" << io::endl;
+    io::cout << "This demonstrates why uninitialized variables cause" << io::endl;
+    io::cout << "different behavior in debug vs release builds." << io::endl;
+    io::cout << "\nKey lessons:" << io::endl;
+    io::cout << "1. Always initialize variables" << io::endl;
+    io::cout << "2. Use compiler warnings (-Wall -Wextra)" << io::endl;
+    io::cout << "3. Test in both debug and release configurations" << io::endl;
+    io::cout << "4. Use instrumentation to track down mysterious bugs" << io::endl;
+    
+    LOG_INFO(logger, "Bug demonstration completed");
+#ifndef TRACE_DISABLED
+    TraceRegistry::instance().writeChromeTrace("trace.json");   // chrome://tracing or ui.perfetto.dev
+#endif
+    UninitMonitor::detach();
     
     return 0;
 }
@@ -159,6 +177,29 @@ clang++ -g -O0 debug_vs_release_bug.cpp -o debug_bug
 Release build (no initialization):
 clang++ -O2 -DNDEBUG debug_vs_release_bug.cpp -o release_bug
 
+Release build with the asynchronous logger (see logger.h):
+clang++ -O2 -DNDEBUG -DASYNC_LOG -pthread debug_vs_release_bug.cpp -o release_bug_async
+
+Release build without Debug-level log lines (no call, no argument evaluation):
+clang++ -O2 -DNDEBUG "-DLOG_MIN_LEVEL=LogLevel::Info" debug_vs_release_bug.cpp -o release_bug_info
+
+Release build with the binary log (debug_log.bin instead of debug_log.txt):
+clang++ -O2 -DNDEBUG -DBINARY_LOG debug_vs_release_bug.cpp -o release_bug_binary
+clang++ -O2 log_decode.cpp -o log_decode && ./log_decode debug_log.bin
+
+Release build with the memory-mapped log (debug_log.txt.000, see mmap_log.h):
+clang++ -O2 -DNDEBUG -DMMAP_LOG debug_vs_release_bug.cpp -o release_bug_mmap
+
+Release build with uninitialized-read instrumentation (see uninit_check.h);
+UNINIT_READ events land in debug_log.txt, exit code 1 if validation fails:
+clang++ -std=c++17 -O2 -DNDEBUG -DUNINIT_CHECK -ftrivial-auto-var-init=pattern debug_vs_release_bug.cpp -o release_bug_uninit
+
+Every build also writes trace.json (TRACE_SCOPE enter/exit times): open it
+in chrome://tracing or https://ui.perfetto.dev. -DTRACE_DISABLED removes
+both the scopes and the trace.json export.
+
 Compare the outputs to see the difference!
+Or let the differential runner build, run and diff all -O levels:
+../tools/diff_runner.sh debug_vs_release_bug.cpp
 ===============================================================================
 */
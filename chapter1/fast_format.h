@@ -0,0 +1,194 @@
+/*
+===============================================================================
+TITLE: Fast integer formatting into a growable, chunk-flushed buffer
+TOPIC: What std::cout << value really costs, and how to avoid it
+
+WHAT operator<< DOES FOR EVERY INT:
+- Constructs a sentry (tie flush check, stream state check)
+- Goes through the locale: num_put facet, grouping, fill and width
+- std::endl adds a flush - one write() system call per line
+
+THIS HEADER:
+- formatInteger(out, value) : std::to_chars-style, writes the digits and
+  returns the end pointer; no locale, no sentry, no allocation
+- Digits are produced two at a time from a 200-byte "00".."99" table, so
+  a 10-digit number needs 5 divisions instead of 10
+- FormatBuffer : reusable buffer that grows on demand and hands its
+  contents to a FILE* in large chunks (64 KB by default) with fwrite
+
+PORTABILITY:
+- Plain C++11 (no std::to_chars, no std::span) so the same header serves
+  the C++11 chapter1 programs and the C++23 std::print builds in chapter2
+- Output goes through stdio, the stream std::print(stdout) and (with the
+  default sync_with_stdio(true)) std::cout also use, so the three can be
+  mixed without reordering lines
+
+USAGE:
+    FormatBuffer out;                         // stdout
+    for (int value : values) out.append(value).append(' ');
+    out.append('\n').flush();
+===============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Longest decimal integer: "-9223372036854775808" and "18446744073709551615"
+const std::size_t kMaxIntegerChars = 20;
+
+// "00" "01" ... "99" - digit pair i lives at kDigitPairs + 2 * i
+inline const char* digitPairs() {
+    static const char table[201] =
+        "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+        "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
+    return table;
+}
+
+inline unsigned countDigits(std::uint32_t value) {
+    if (value < 10) return 1;
+    if (value < 100) return 2;
+    if (value < 1000) return 3;
+    if (value < 10000) return 4;
+    if (value < 100000) return 5;
+    if (value < 1000000) return 6;
+    if (value < 10000000) return 7;
+    if (value < 100000000) return 8;
+    if (value < 1000000000) return 9;
+    return 10;
+}
+
+inline unsigned countDigits(std::uint64_t value) {
+    unsigned digits = 1;
+    while (value >= 10000) {
+        value /= 10000;
+        digits += 4;
+    }
+    return digits - 1 + countDigits(static_cast<std::uint32_t>(value));
+}
+
+// Writes the digits backwards from end, two per division
+template <typename Unsigned>
+inline void writeDigitsBackwards(char* end, Unsigned value) {
+    const char* pairs = digitPairs();
+    while (value >= 100) {
+        unsigned pair = static_cast<unsigned>(value % 100) * 2;
+        value /= 100;
+        end -= 2;
+        std::memcpy(end, pairs + pair, 2);
+    }
+    if (value >= 10) {
+        std::memcpy(end - 2, pairs + static_cast<unsigned>(value) * 2, 2);
+    } else {
+        end[-1] = static_cast<char>('0' + value);
+    }
+}
+
+inline char* formatDecimal(char* out, std::uint64_t value) {
+    // 32-bit division is several times cheaper; most values fit
+    if (value <= 0xFFFFFFFFu) {
+        std::uint32_t small = static_cast<std::uint32_t>(value);
+        char* end = out + countDigits(small);
+        writeDigitsBackwards(end, small);
+        return end;
+    }
+    char* end = out + countDigits(value);
+    writeDigitsBackwards(end, value);
+    return end;
+}
+
+// Like std::to_chars(out, out + kMaxIntegerChars, value).ptr, for any integer type
+template <typename Integer>
+inline char* formatInteger(char* out, Integer value) {
+    static_assert(std::is_integral<Integer>::value, "formatInteger needs an integer");
+    typedef typename std::make_unsigned<Integer>::type Unsigned;
+    Unsigned magnitude = static_cast<Unsigned>(value);
+    if (value < 0) {
+        *out++ = '-';
+        magnitude = static_cast<Unsigned>(0u - magnitude);   // Also right for the minimum value
+    }
+    return formatDecimal(out, static_cast<std::uint64_t>(magnitude));
+}
+
+/*
+===============================================================================
+FORMAT BUFFER
+===============================================================================
+*/
+
+class FormatBuffer {
+private:
+    std::FILE* stream;
+    std::vector<char> data;
+    std::size_t used = 0;
+    std::size_t chunk;
+
+    // Pointer to n writable bytes; flushes a full chunk, grows otherwise
+    char* room(std::size_t n) {
+        if (data.size() - used < n) {
+            if (used > 0 && used + n > chunk) flush();
+            if (data.size() - used < n) {
+                std::size_t grown = data.size() * 2;
+                data.resize(grown > used + n ? grown : used + n);
+            }
+        }
+        return &data[0] + used;
+    }
+
+public:
+    explicit FormatBuffer(std::FILE* output = stdout, std::size_t chunkBytes = 64 * 1024)
+        : stream(output), data(256), chunk(chunkBytes) {}
+
+    FormatBuffer(const FormatBuffer&) = delete;
+    FormatBuffer& operator=(const FormatBuffer&) = delete;
+
+    FormatBuffer& append(const char* text, std::size_t length) {
+        std::memcpy(room(length), text, length);
+        used += length;
+        return *this;
+    }
+
+    FormatBuffer& append(const char* text) { return append(text, std::strlen(text)); }
+
+    FormatBuffer& append(char c) {
+        *room(1) = c;
+        ++used;
+        return *this;
+    }
+
+    // Every integer type except char, which is text above
+    template <typename Integer>
+    typename std::enable_if<std::is_integral<Integer>::value, FormatBuffer&>::type append(Integer value) {
+        char* out = room(kMaxIntegerChars);
+        used = static_cast<std::size_t>(formatInteger(out, value) - &data[0]);
+        return *this;
+    }
+
+    // Writes the pending bytes with one fwrite; capacity is kept for reuse
+    FormatBuffer& flush() {
+        if (used > 0) std::fwrite(&data[0], 1, used, stream);
+        used = 0;
+        return *this;
+    }
+
+    std::size_t size() const { return used; }
+    std::size_t capacity() const { return data.size(); }
+    const char* begin() const { return &data[0]; }
+
+    // Drops the pending bytes without writing them
+    void clear() { used = 0; }
+
+    ~FormatBuffer() { flush(); }
+};
+
+// One reusable buffer per thread for the print() helpers; nothing to allocate after warm-up
+inline FormatBuffer& stdoutBuffer() {
+    static thread_local FormatBuffer buffer(stdout);
+    return buffer;
+}
@@ -0,0 +1,98 @@
+/*
+===============================================================================
+TITLE: std::cout stand-in for the lean build (-DLEAN_OUTPUT)
+TOPIC: Startup latency and binary size of small, frequently launched tools
+
+    #ifdef LEAN_OUTPUT
+    #include "lean_out.h"     // io::cout on stdio, no <iostream>
+    namespace io = lean;
+    #else
+    #include <iostream>
+    namespace io = std;
+    #endif
+    ...
+    io::cout << "b is " << value << io::endl;
+
+WHAT <iostream> COSTS A TINY PROGRAM:
+- Every translation unit that includes it gets a static std::ios_base::Init
+  object; its constructor builds cout/cin/cerr/clog (and wide versions),
+  their stream buffers and locale facets before main() even starts
+- It drags locale, num_put and the stream templates into the link, which a
+  static binary has to carry in full
+
+THIS HEADER:
+- lean::cout only knows text, characters and integers and appends them to
+  the same thread-local FormatBuffer that print() uses (fast_format.h), so
+  the output reaches stdout through stdio: no static initialization, no
+  locale, and the order with print() / printf output is kept
+- lean::endl flushes like std::endl: the buffer, then stdout
+
+The rest of the lean build is in CMakeLists.txt (CHAPTER1_LEAN,
+CHAPTER1_STATIC); tools/startup_bench.sh measures both modes.
+===============================================================================
+*/
+
+#pragma once
+
+#include <cstdio>
+#include <string>
+#include <type_traits>
+
+#include "fast_format.h"
+
+namespace lean {
+
+struct Endl {};
+constexpr Endl endl{};
+
+class Out {
+public:
+    Out& operator<<(const char* text) {
+        stdoutBuffer().append(text);
+        return *this;
+    }
+
+    Out& operator<<(const std::string& text) {
+        stdoutBuffer().append(text.data(), text.size());
+        return *this;
+    }
+
+    Out& operator<<(char c) {
+        stdoutBuffer().append(c);
+        return *this;
+    }
+
+    // Like std::cout without boolalpha: 1 or 0
+    Out& operator<<(bool value) {
+        stdoutBuffer().append(value ? '1' : '0');
+        return *this;
+    }
+
+    template <typename Integer>
+    typename std::enable_if<std::is_integral<Integer>::value, Out&>::type operator<<(Integer value) {
+        stdoutBuffer().append(value);
+        return *this;
+    }
+
+    Out& operator<<(Endl) {
+        stdoutBuffer().append('\n').flush();
+        std::fflush(stdout);
+        return *this;
+    }
+
+    Out& write(const char* text, std::size_t length) {
+        stdoutBuffer().append(text, length);
+        return *this;
+    }
+
+    Out& flush() {
+        stdoutBuffer().flush();
+        std::fflush(stdout);
+        return *this;
+    }
+};
+
+// Stateless: every translation unit may have its own, they share one buffer
+static Out cout;
+
+}  // namespace lean
@@ -0,0 +1,156 @@
+/*
+===============================================================================
+TITLE: Offline decoder for debug_log.bin
+TOPIC: Deferred formatting - the formatting happens here, not in the program
+
+USAGE:
+    ./log_decode debug_log.bin              # Print the text log to stdout
+    ./log_decode debug_log.bin out.txt      # Write it to a file instead
+
+The output matches what the text Logger writes to debug_log.txt:
+    === PROGRAM START ===
+    [LOG] ...
+    === PROGRAM END ===
+
+See binary_log.h for the file layout.
+===============================================================================
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "binary_log.h"
+
+class Reader {
+private:
+    const std::vector<char>& data;
+    std::size_t pos = 0;
+
+public:
+    explicit Reader(const std::vector<char>& bytes) : data(bytes) {}
+
+    bool has(std::size_t size) const { return data.size() - pos >= size; }
+
+    template <typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, data.data() + pos, sizeof(T));
+        pos += sizeof(T);
+        return value;
+    }
+
+    std::string readBytes(std::size_t size) {
+        std::string bytes(data.data() + pos, size);
+        pos += size;
+        return bytes;
+    }
+};
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " debug_log.bin [out.txt]" << std::endl;
+        return 2;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (data.size() < sizeof(kBinaryLogMagic) ||
+        std::memcmp(data.data(), kBinaryLogMagic, sizeof(kBinaryLogMagic)) != 0) {
+        std::cerr << argv[1] << ": not a binary log" << std::endl;
+        return 1;
+    }
+
+    std::ofstream file;
+    if (argc > 2) file.open(argv[2]);
+    std::ostream& out = argc > 2 ? static_cast<std::ostream&>(file) : std::cout;
+
+    Reader reader(data);
+    reader.readBytes(sizeof(kBinaryLogMagic));
+    out << "=== PROGRAM START ===\n";
+
+    std::vector<std::string> formats;
+    bool complete = false;
+    while (reader.has(1)) {
+        char kind = reader.read<char>();
+
+        if (kind == 'F' && reader.has(4)) {
+            std::uint16_t id = reader.read<std::uint16_t>();
+            std::uint16_t length = reader.read<std::uint16_t>();
+            if (!reader.has(length)) break;
+            if (formats.size() <= id) formats.resize(id + 1u);
+            formats[id] = reader.readBytes(length);
+
+        } else if (kind == 'E' && reader.has(3)) {
+            std::uint16_t id = reader.read<std::uint16_t>();
+            std::uint8_t argc = reader.read<std::uint8_t>();
+            if (id >= formats.size()) break;
+
+            // Same "{}" substitution rules as the text Logger
+            std::string line;
+            const char* format = formats[id].c_str();
+            char field[kMaxStringArg + 64];
+            bool truncated = false;
+            for (std::uint8_t i = 0; i < argc && !truncated; ++i) {
+                LogLineBuilder builder{field, sizeof(field)};
+                bool hasField = builder.nextField(format);
+                if (!reader.has(1)) { truncated = true; break; }
+                char tag = reader.read<char>();
+                if (tag == 's') {
+                    if (!reader.has(2)) { truncated = true; break; }
+                    std::uint16_t length = reader.read<std::uint16_t>();
+                    if (!reader.has(length)) { truncated = true; break; }
+                    std::string text = reader.readBytes(length);
+                    if (hasField) builder.appendArg(text);
+                } else if (reader.has(8) && tag == 'i') {
+                    long long value = reader.read<std::int64_t>();
+                    if (hasField) builder.appendArg(value);
+                } else if (reader.has(8) && tag == 'u') {
+                    unsigned long long value = reader.read<std::uint64_t>();
+                    if (hasField) builder.appendArg(value);
+                } else if (reader.has(8) && tag == 'd') {
+                    double value = reader.read<double>();
+                    if (hasField) builder.appendArg(value);
+                } else {
+                    truncated = true;
+                    break;
+                }
+                line.append(field, builder.length);
+            }
+            if (truncated) break;
+            // Text after the last argument, left-over "{}" kept like the text Logger
+            std::string rest(std::strlen(format), '\0');
+            LogLineBuilder tail{&rest[0], rest.size()};
+            tail.format(format);
+            line.append(rest.data(), tail.length);
+            out << "[LOG] " << line << '\n';
+
+        } else if (kind == 'Z') {
+            complete = true;
+            break;
+        } else {
+            break;
+        }
+    }
+
+    if (complete) {
+        out << "=== PROGRAM END ===\n";
+    } else {
+        std::cerr << argv[1] << ": log ends early (program crashed or still running?)" << std::endl;
+    }
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -O2 -DNDEBUG -DBINARY_LOG debug_vs_release_bug.cpp -o release_bug_binary
+clang++ -O2 log_decode.cpp -o log_decode
+./release_bug_binary && ./log_decode debug_log.bin
+===============================================================================
+*/
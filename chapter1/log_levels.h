@@ -0,0 +1,179 @@
+/*
+===============================================================================
+TITLE: Compile-time log levels and statically composed sinks
+TOPIC: Zero-overhead disabled logging
+
+    StaticLogger<LogLevel::Info, FileSink, ConsoleSink> logger{...};
+    LOG_DEBUG(logger, "Value of featureEnabled: {}", featureEnabled);
+
+COMPILE-TIME THRESHOLD:
+- The level is a template parameter, so LOG_DEBUG on an Info logger expands
+  to an `if constexpr (false)` block: no call, no format registration and
+  the arguments are never evaluated - even at -O0
+
+RUNTIME FILTER:
+- Levels at or above the threshold are still checked against a runtime
+  level: exactly one relaxed atomic load, no lock, no fence
+
+STATIC SINKS:
+- Sinks are plain classes stored in a std::tuple and called directly, so
+  there is no virtual dispatch and every sink call can be inlined
+- A sink only needs:
+      template <typename... Args>
+      void write(LogLevel, const LogFormat&, const Args&...);
+===============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "logger.h"
+
+#ifdef LEAN_OUTPUT
+#include <cstdio>
+#include <memory>
+#else
+#include <fstream>
+#include <iostream>
+#endif
+
+enum class LogLevel : int { Trace, Debug, Info, Warn, Error, Off };
+
+/*
+===============================================================================
+SINKS
+===============================================================================
+*/
+
+// Formats "[LOG] message" into a stack buffer - shared by the text sinks
+template <typename... Args>
+std::size_t formatLogLine(char (&line)[kLogLineText], const LogFormat& format, const Args&... args) {
+    LogLineBuilder builder{line, sizeof(line)};
+    builder.append("[LOG] ", 6);
+    const char* rest = format.text;
+    builder.format(rest, args...);
+    return builder.length;
+}
+
+#ifdef LEAN_OUTPUT
+// Lean build: the same sinks on stdio, flushing where std::endl did
+struct ConsoleSink {
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        char line[kLogLineText];
+        std::size_t length = formatLogLine(line, format, args...);
+        stdoutBuffer().append(line, length).append('\n').flush();
+        std::fflush(stdout);
+    }
+};
+
+struct FileSink {
+    std::unique_ptr<std::FILE, int (*)(std::FILE*)> file;
+
+    explicit FileSink(const char* path) : file(std::fopen(path, "w"), &std::fclose) {}
+
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        if (!file) return;
+        char line[kLogLineText];
+        std::size_t length = formatLogLine(line, format, args...);
+        std::fwrite(line, 1, length, file.get());
+        std::fputc('\n', file.get());
+        std::fflush(file.get());
+    }
+};
+#else
+struct ConsoleSink {
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        char line[kLogLineText];
+        std::size_t length = formatLogLine(line, format, args...);
+        std::cout.write(line, static_cast<std::streamsize>(length)) << std::endl;
+    }
+};
+
+struct FileSink {
+    std::ofstream file;
+
+    explicit FileSink(const char* path) : file(path) {}
+
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        char line[kLogLineText];
+        std::size_t length = formatLogLine(line, format, args...);
+        file.write(line, static_cast<std::streamsize>(length)) << std::endl;
+    }
+};
+#endif
+
+// Forwards to an existing Logger, keeping its sync/async/binary backends
+struct LoggerSink {
+    Logger& logger;
+
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        logger.logf(format, args...);
+    }
+};
+
+/*
+===============================================================================
+STATIC LOGGER
+===============================================================================
+*/
+
+template <LogLevel Threshold, typename... Sinks>
+class StaticLogger {
+private:
+    std::tuple<Sinks...> sinks;
+    std::atomic<int> runtimeLevel{static_cast<int>(Threshold)};
+
+public:
+    static constexpr LogLevel threshold = Threshold;
+
+    explicit StaticLogger(Sinks... sinkList) : sinks(std::move(sinkList)...) {}
+
+    // Can only raise the bar: levels below Threshold no longer exist in the binary
+    void setLevel(LogLevel level) {
+        runtimeLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+
+    bool enabled(LogLevel level) const {
+        return static_cast<int>(level) >= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    template <typename... Args>
+    void write(LogLevel level, const LogFormat& format, const Args&... args) {
+        std::apply([&](auto&... sink) { (sink.write(level, format, args...), ...); }, sinks);
+    }
+
+    template <std::size_t I>
+    auto& sink() { return std::get<I>(sinks); }
+};
+
+/*
+===============================================================================
+LOGGING MACROS - The only way arguments can be skipped without evaluation
+===============================================================================
+*/
+
+#define LOG_AT(logger, level, format, ...)                                          \
+    do {                                                                            \
+        if constexpr (static_cast<int>(level) >=                                    \
+                      static_cast<int>(std::remove_reference_t<decltype(logger)>::threshold)) { \
+            if ((logger).enabled(level)) {                                          \
+                static const LogFormat logFormat_(format);                          \
+                (logger).write(level, logFormat_, ##__VA_ARGS__);                   \
+            }                                                                       \
+        }                                                                           \
+    } while (0)
+
+#define LOG_TRACE(logger, ...) LOG_AT(logger, LogLevel::Trace, __VA_ARGS__)
+#define LOG_DEBUG(logger, ...) LOG_AT(logger, LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(logger, ...)  LOG_AT(logger, LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(logger, ...)  LOG_AT(logger, LogLevel::Warn, __VA_ARGS__)
+#define LOG_ERROR(logger, ...) LOG_AT(logger, LogLevel::Error, __VA_ARGS__)
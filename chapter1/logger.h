@@ -0,0 +1,400 @@
+/*
+===============================================================================
+TITLE: Logger used by debug_vs_release_bug.cpp
+TOPIC: Synchronous vs asynchronous vs binary logging
+
+SYNCHRONOUS MODE (default, Logger()):
+- Every log() call writes "[LOG] message" to debug_log.txt and to std::cout
+- std::endl flushes both streams, so every call pays for two syscalls
+- Simple and ordered with the rest of the console output
+
+ASYNCHRONOUS MODE (Logger(AsyncLogConfig{...})):
+- Producers copy the message into a bounded MPSC lock-free ring and return
+- One background thread drains the ring and batches records into large
+  write() calls on the log file (and the console, if echo is enabled)
+- The timestamp is captured on the producer side with steady_clock (a vDSO
+  call, no syscall) and drives the writer's flush deadline
+- When the ring is full the OverflowPolicy decides what happens
+
+BINARY MODE (Logger(BinaryLogConfig{...})):
+- LOG_FMT call sites append only a format id plus raw arguments to
+  debug_log.bin (see binary_log.h); nothing is formatted or echoed
+- log_decode.cpp turns the file back into the debug_log.txt text
+
+MEMORY-MAPPED MODE (Logger(MmapLogConfig{...})):
+- Lines are reserved with one atomic fetch_add and memcpy'd into mapped,
+  preallocated segments debug_log.txt.000, .001, ... (see mmap_log.h)
+- No lock and no syscall per line; lines of a crashed run are recovered
+  on the next start. Nothing is echoed to the console
+
+LOG_FMT(logger, "Value: {}", x) works in every mode: the text modes format
+into a stack buffer instead of building std::string temporaries.
+
+LINE LENGTH LIMITS:
+- Formatted text lines (LOG_FMT, LOG_* / StaticLogger) hold kLogLineText
+  (2048) bytes; binary string arguments hold kMaxStringArg (1024) bytes
+- Async records hold kLogRecordText (240) bytes, so a record stays 256 bytes
+- A line cut at either limit ends in "..."; log(text) is never cut in the
+  synchronous mode (memory-mapped: a quarter of a segment, binary:
+  kMaxStringArg)
+
+LEAN BUILD (-DLEAN_OUTPUT, see lean_out.h):
+- The synchronous mode writes through stdio (fopen/fwrite, then fflush
+  where std::endl flushed) instead of std::ofstream and std::cout, so the
+  program does not need <iostream> and its static initialization
+
+NOTE: In async mode console lines are written by the background thread, so
+they can interleave differently with direct std::cout output of the program.
+===============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "binary_log.h"
+#include "mmap_log.h"
+
+#ifdef LEAN_OUTPUT
+#include <cstdio>
+#include "fast_format.h"
+#else
+#include <fstream>
+#include <iostream>
+#endif
+
+/*
+===============================================================================
+ASYNC CONFIGURATION
+===============================================================================
+*/
+
+// What a producer does when the ring has no free slot
+enum class OverflowPolicy {
+    Block,  // Wait (spin + yield) until the writer frees a slot - nothing is lost
+    Drop,   // Discard the record silently - never waits, no bookkeeping
+    Count   // Discard the record and count it; the writer logs how many were lost
+};
+
+// When the background writer hands its batch to write()
+struct FlushPolicy {
+    std::size_t batchBytes = 64 * 1024;          // Flush once this much text is pending
+    std::chrono::milliseconds maxDelay{50};      // ...or once the oldest pending record is this old
+    bool everyRecord = false;                    // One write() per record (old std::endl behaviour)
+};
+
+struct AsyncLogConfig {
+    std::size_t capacity = 4096;                 // Ring slots, rounded up to a power of two
+    OverflowPolicy overflow = OverflowPolicy::Block;
+    FlushPolicy flush;
+    bool echoToConsole = true;                   // Also write batches to stdout
+};
+
+/*
+===============================================================================
+BOUNDED MPSC RING - Producers never take a lock
+===============================================================================
+Classic sequence-numbered bounded queue (D. Vyukov):
+- Each slot carries a sequence number telling who may touch it next
+- Producers claim a position with a CAS on head, fill the slot, then publish
+  it with a release store of the sequence number
+- The single consumer reads slots in order and hands them back to producers
+  by bumping the sequence number one lap ahead
+===============================================================================
+*/
+
+constexpr std::size_t kLogRecordText = 240;      // Longer messages are cut and end in "..."
+
+struct LogRecord {
+    std::int64_t timestamp;                      // steady_clock ticks, taken by the producer
+    std::uint32_t length;
+    char text[kLogRecordText];
+};
+
+class MpscLogRing {
+private:
+    struct alignas(64) Slot {
+        std::atomic<std::size_t> sequence;
+        LogRecord record;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head{0};    // Next position to claim (producers)
+    alignas(64) std::size_t tail = 0;                // Next position to read (consumer only)
+
+public:
+    explicit MpscLogRing(std::size_t capacity) {
+        std::size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots.reset(new Slot[size]);
+        mask = size - 1;
+        for (std::size_t i = 0; i < size; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(std::int64_t timestamp, const char* text, std::size_t length) {
+        std::size_t pos = head.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots[pos & mask];
+            std::size_t seq = slot->sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0) {
+                if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false;                        // Ring is full
+            } else {
+                pos = head.load(std::memory_order_relaxed);
+            }
+        }
+        slot->record.timestamp = timestamp;
+        if (length > kLogRecordText) {
+            std::memcpy(slot->record.text, text, kLogRecordText - 3);
+            std::memcpy(slot->record.text + kLogRecordText - 3, "...", 3);
+            length = kLogRecordText;
+        } else {
+            std::memcpy(slot->record.text, text, length);
+        }
+        slot->record.length = static_cast<std::uint32_t>(length);
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side: hand the oldest record to f in place, then free its slot
+    template <typename F>
+    bool consume(F&& f) {
+        Slot& slot = slots[tail & mask];
+        if (slot.sequence.load(std::memory_order_acquire) != tail + 1) return false;
+        f(slot.record);
+        slot.sequence.store(tail + mask + 1, std::memory_order_release);
+        ++tail;
+        return true;
+    }
+};
+
+/*
+===============================================================================
+ASYNC WRITER - The only thread that touches the file descriptors
+===============================================================================
+*/
+
+class AsyncLogWriter {
+private:
+    AsyncLogConfig config;
+    MpscLogRing ring;
+    int fd;
+    std::atomic<bool> stopping{false};
+    std::atomic<std::uint64_t> dropped{0};
+    std::thread writer;
+
+    static std::int64_t now() {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    static void writeAll(int out, const char* data, std::size_t size) {
+        while (size > 0) {
+            ssize_t written = ::write(out, data, size);
+            if (written <= 0) return;                // Nothing sensible to do on a failing log
+            data += written;
+            size -= static_cast<std::size_t>(written);
+        }
+    }
+
+    void flush(std::string& batch) {
+        if (batch.empty()) return;
+        writeAll(fd, batch.data(), batch.size());
+        if (config.echoToConsole) writeAll(STDOUT_FILENO, batch.data(), batch.size());
+        batch.clear();
+    }
+
+    void run() {
+        const std::int64_t maxDelay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            config.flush.maxDelay).count();
+        std::string batch;
+        batch.reserve(config.flush.batchBytes + kLogRecordText + 16);
+        std::int64_t oldestPending = 0;
+        std::uint64_t reportedDrops = 0;
+
+        for (;;) {
+            // Read the flag before draining so nothing pushed before stop is missed
+            bool stop = stopping.load(std::memory_order_acquire);
+            bool drained = false;
+
+            while (ring.consume([&](const LogRecord& record) {
+                if (batch.empty()) oldestPending = record.timestamp;
+                batch.append("[LOG] ", 6);
+                batch.append(record.text, record.length);
+                batch.push_back('\n');
+            })) {
+                drained = true;
+                if (config.flush.everyRecord || batch.size() >= config.flush.batchBytes) flush(batch);
+            }
+
+            std::uint64_t lost = dropped.load(std::memory_order_relaxed);
+            if (lost != reportedDrops) {
+                batch += "[LOG] " + std::to_string(lost - reportedDrops) + " records dropped (ring full)\n";
+                reportedDrops = lost;
+            }
+
+            if (stop) break;
+            if (!batch.empty() && now() - oldestPending >= maxDelay) flush(batch);
+            if (!drained) std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+
+        flush(batch);
+        const char end[] = "=== PROGRAM END ===\n";
+        writeAll(fd, end, sizeof(end) - 1);
+    }
+
+public:
+    AsyncLogWriter(const char* path, const AsyncLogConfig& cfg)
+        : config(cfg), ring(cfg.capacity),
+          fd(::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) {
+        const char start[] = "=== PROGRAM START ===\n";
+        writeAll(fd, start, sizeof(start) - 1);
+        writer = std::thread([this] { run(); });
+    }
+
+    AsyncLogWriter(const AsyncLogWriter&) = delete;
+    AsyncLogWriter& operator=(const AsyncLogWriter&) = delete;
+
+    // Producer side: one clock read, one memcpy, no allocation, no syscall
+    void push(const char* text, std::size_t length) {
+        std::int64_t timestamp = now();
+        if (ring.tryPush(timestamp, text, length)) return;
+
+        switch (config.overflow) {
+            case OverflowPolicy::Block:
+                while (!ring.tryPush(timestamp, text, length)) std::this_thread::yield();
+                break;
+            case OverflowPolicy::Drop:
+                break;
+            case OverflowPolicy::Count:
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                break;
+        }
+    }
+
+    std::uint64_t droppedRecords() const { return dropped.load(std::memory_order_relaxed); }
+
+    ~AsyncLogWriter() {
+        stopping.store(true, std::memory_order_release);
+        writer.join();
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+/*
+===============================================================================
+LOGGER - Same interface for every mode
+===============================================================================
+*/
+
+class Logger {
+private:
+#ifdef LEAN_OUTPUT
+    std::FILE* logFile = nullptr;              // Only opened in synchronous mode
+#else
+    std::ofstream logFile;
+#endif
+    std::unique_ptr<AsyncLogWriter> async;     // Set in async mode
+    std::unique_ptr<BinaryLogWriter> binary;   // Set in binary mode
+    std::unique_ptr<MmapLogWriter> mapped;     // Set in memory-mapped mode
+
+public:
+#ifdef LEAN_OUTPUT
+    Logger() : logFile(std::fopen("debug_log.txt", "w")) {
+        if (logFile) {
+            std::fputs("=== PROGRAM START ===\n", logFile);
+            std::fflush(logFile);
+        }
+    }
+#else
+    Logger() : logFile("debug_log.txt") {
+        logFile << "=== PROGRAM START ===" << std::endl;
+    }
+#endif
+
+    explicit Logger(const AsyncLogConfig& config)
+        : async(new AsyncLogWriter("debug_log.txt", config)) {}
+
+    explicit Logger(const BinaryLogConfig& config)
+        : binary(new BinaryLogWriter(config)) {}
+
+    explicit Logger(const MmapLogConfig& config)
+        : mapped(new MmapLogWriter(config)) {}
+
+    void log(const char* message, std::size_t length) {
+        if (async) {
+            async->push(message, length);
+            return;
+        }
+        if (binary) {
+            binary->appendText(message, length);
+            return;
+        }
+        if (mapped) {
+            mapped->append(message, length);
+            return;
+        }
+#ifdef LEAN_OUTPUT
+        if (logFile) {
+            std::fputs("[LOG] ", logFile);
+            std::fwrite(message, 1, length, logFile);
+            std::fputc('\n', logFile);
+            std::fflush(logFile);
+        }
+        stdoutBuffer().append("[LOG] ", 6).append(message, length).append('\n').flush(); // Also output to console
+        std::fflush(stdout);
+#else
+        logFile << "[LOG] ";
+        logFile.write(message, static_cast<std::streamsize>(length)) << std::endl;
+        std::cout << "[LOG] ";
+        std::cout.write(message, static_cast<std::streamsize>(length)) << std::endl; // Also output to console
+#endif
+    }
+
+    // String literals go straight through - no std::string temporary
+    void log(const char* message) { log(message, std::strlen(message)); }
+    void log(const std::string& message) { log(message.data(), message.size()); }
+
+    // Deferred formatting - use through LOG_FMT so the format registers once
+    template <typename... Args>
+    void logf(const LogFormat& format, const Args&... args) {
+        if (binary) {
+            binary->append(format, args...);
+            return;
+        }
+        char line[kLogLineText];
+        LogLineBuilder builder{line, sizeof(line)};
+        const char* rest = format.text;
+        builder.format(rest, args...);
+        log(line, builder.length);
+    }
+
+    ~Logger() {
+#ifdef LEAN_OUTPUT
+        if (logFile) {
+            std::fputs("=== PROGRAM END ===\n", logFile);
+            std::fclose(logFile);
+        }
+#else
+        if (!async && !binary && !mapped) {
+            logFile << "=== PROGRAM END ===" << std::endl;
+        }
+#endif
+    }
+};
@@ -0,0 +1,271 @@
+/*
+===============================================================================
+TITLE: Memory-mapped log segments
+TOPIC: Logging as "reserve + memcpy" into the page cache
+
+    Logger logger(MmapLogConfig{});     // debug_log.txt.000, .001, ...
+
+WHY:
+- std::ofstream copies every line into the stream buffer and std::endl
+  turns it into one write() system call per line
+- Here a producer reserves its bytes with ONE atomic fetch_add on the
+  segment cursor and memcpy's the finished "[LOG] ...\n" line straight
+  into a shared file mapping: no lock, no syscall, no second copy
+
+SEGMENTS:
+- Each segment is a file preallocated to segmentBytes (posix_fallocate)
+  and mapped MAP_SHARED; the lines in it are plain debug_log.txt text
+- A reservation that does not fit rolls over: the first thread to notice
+  maps the next segment under a mutex, everybody retries there
+- Every reservation reports how many of its bytes fell inside the segment;
+  when those add up to segmentBytes nobody can still be copying into it, and
+  that thread unmaps it and truncates the file to the bytes really used
+
+CRASH-SAFE TAIL:
+- MAP_SHARED pages belong to the page cache, so lines already copied survive
+  a crash of the process (use syncToDisk() if power loss matters too)
+- A segment of a crashed run still has its zero-filled preallocated tail and
+  maybe torn lines (reserved, not fully copied). The constructor repairs such
+  segments: it keeps every complete line without NUL bytes, drops the rest,
+  notes the loss in a "=== RECOVERED ... ===" line, truncates the file and
+  keeps it as debug_log.txt.NNN.recovered; the new run starts again at .000
+- Segments of a run that ended normally are simply replaced, like the
+  truncating std::ofstream of the synchronous Logger
+===============================================================================
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct MmapLogConfig {
+    const char* path = "debug_log.txt";         // Segments are path.000, path.001, ...
+    std::size_t segmentBytes = 16 * 1024 * 1024;
+};
+
+// What the constructor found left over from earlier runs
+struct MmapLogRecovery {
+    std::size_t segmentsFound = 0;
+    std::size_t segmentsRepaired = 0;
+    std::size_t bytesDropped = 0;                // Bytes of torn lines (zero tails are not counted)
+};
+
+class MmapLogWriter {
+private:
+    struct Segment {
+        std::string path;
+        int fd = -1;
+        char* base = nullptr;
+        std::size_t capacity = 0;
+        std::atomic<std::size_t> cursor{0};      // Next free byte (may run past capacity)
+        std::atomic<std::size_t> settled{0};     // In-segment bytes whose copy is finished
+        std::atomic<std::size_t> dataEnd;        // Where the text ends, set by the straddling reservation
+
+        explicit Segment(std::size_t size) : capacity(size), dataEnd(size) {}
+    };
+
+    MmapLogConfig config;
+    MmapLogRecovery recovered;
+    std::mutex rolloverLock;
+    // Segments are never freed before the writer: a late producer may still touch their counters
+    std::vector<std::unique_ptr<Segment>> segments;
+    std::atomic<Segment*> current{nullptr};
+    unsigned nextIndex = 0;
+
+    std::string segmentPath(unsigned index) const {
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), ".%03u", index);
+        return std::string(config.path) + suffix;
+    }
+
+    // Keeps complete lines without NUL bytes; returns false if the file was already clean
+    bool repair(const std::string& file) {
+        int fd = ::open(file.c_str(), O_RDWR);
+        if (fd < 0) return false;
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size == 0) {
+            ::close(fd);
+            return false;
+        }
+        std::string content(static_cast<std::size_t>(info.st_size), '\0');
+        if (::pread(fd, &content[0], content.size(), 0) != static_cast<ssize_t>(content.size()) ||
+            (content.back() == '\n' && content.find('\0') == std::string::npos)) {
+            ::close(fd);
+            return false;
+        }
+
+        std::string kept;
+        kept.reserve(content.size());
+        std::size_t start = 0;
+        while (start < content.size()) {
+            std::size_t newline = content.find('\n', start);
+            if (newline == std::string::npos) break;   // Unterminated tail
+            if (std::memchr(content.data() + start, '\0', newline - start) == nullptr) {
+                kept.append(content, start, newline - start + 1);
+            }
+            start = newline + 1;
+        }
+        // Zero bytes are only unused preallocation; everything else not kept was torn
+        std::size_t written = content.size() - static_cast<std::size_t>(std::count(content.begin(), content.end(), '\0'));
+        std::size_t torn = written - kept.size();
+        char note[96];
+        int length = std::snprintf(note, sizeof(note), "=== RECOVERED AFTER CRASH: %zu torn bytes dropped ===\n", torn);
+        kept.append(note, static_cast<std::size_t>(length));
+
+        ::pwrite(fd, kept.data(), kept.size(), 0);
+        ::ftruncate(fd, static_cast<off_t>(kept.size()));
+        ::close(fd);
+        recovered.bytesDropped += torn;
+        return true;
+    }
+
+    // Segments of a cleanly finished run are deleted (the log restarts, like
+    // std::ofstream); segments of a crashed run are repaired and kept as
+    // <segment>.recovered until the next crash
+    void recoverPreviousRun() {
+        std::vector<std::string> found;
+        bool crashed = false;
+        for (unsigned index = 0;; ++index) {
+            std::string file = segmentPath(index);
+            if (::access(file.c_str(), F_OK) != 0) break;
+            found.push_back(file);
+            if (repair(file)) {
+                crashed = true;
+                ++recovered.segmentsRepaired;
+            }
+        }
+        recovered.segmentsFound = found.size();
+        for (const std::string& file : found) {
+            if (crashed) {
+                std::rename(file.c_str(), (file + ".recovered").c_str());
+            } else {
+                std::remove(file.c_str());
+            }
+        }
+    }
+
+    Segment* openSegment() {
+        std::unique_ptr<Segment> segment(new Segment(config.segmentBytes));
+        segment->path = segmentPath(nextIndex++);
+        segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (segment->fd >= 0) {
+            if (::posix_fallocate(segment->fd, 0, static_cast<off_t>(segment->capacity)) != 0) {
+                ::ftruncate(segment->fd, static_cast<off_t>(segment->capacity));   // e.g. tmpfs: sparse
+            }
+            void* mapping = ::mmap(nullptr, segment->capacity, PROT_READ | PROT_WRITE, MAP_SHARED, segment->fd, 0);
+            segment->base = mapping == MAP_FAILED ? nullptr : static_cast<char*>(mapping);
+            // The first store to each page of a shared file mapping faults (dirty
+            // tracking): take those faults now, once, instead of on the hot path
+            long page = ::sysconf(_SC_PAGESIZE);
+            for (std::size_t offset = 0; segment->base != nullptr && offset < segment->capacity;
+                 offset += static_cast<std::size_t>(page)) {
+                segment->base[offset] = '\0';
+            }
+        }
+        segments.push_back(std::move(segment));
+        return segments.back().get();
+    }
+
+    // Called once per segment, by whoever settles its last byte (or by the destructor)
+    static void closeSegment(Segment& segment) {
+        if (segment.base != nullptr) ::munmap(segment.base, segment.capacity);
+        segment.base = nullptr;
+        if (segment.fd >= 0) {
+            ::ftruncate(segment.fd, static_cast<off_t>(segment.dataEnd.load(std::memory_order_acquire)));
+            ::close(segment.fd);
+        }
+        segment.fd = -1;
+    }
+
+    static void settle(Segment& segment, std::size_t bytes) {
+        if (bytes == 0) return;
+        if (segment.settled.fetch_add(bytes, std::memory_order_acq_rel) + bytes == segment.capacity) {
+            closeSegment(segment);
+        }
+    }
+
+    void rollover(Segment* full) {
+        std::lock_guard<std::mutex> guard(rolloverLock);
+        if (current.load(std::memory_order_acquire) == full) {
+            current.store(openSegment(), std::memory_order_release);
+        }
+    }
+
+    // One reservation for prefix + text, plus '\n' when newline is set; the
+    // START/END markers carry their own '\n' and pass false
+    void reserveAndCopy(const char* prefix, std::size_t prefixLength, const char* text, std::size_t length,
+                        bool newline) {
+        length = std::min(length, config.segmentBytes / 4);   // Any line fits in a fresh segment
+        std::size_t size = prefixLength + length + (newline ? 1 : 0);
+        for (;;) {
+            Segment* segment = current.load(std::memory_order_acquire);
+            std::size_t position = segment->cursor.fetch_add(size, std::memory_order_relaxed);
+            if (position + size <= segment->capacity) {
+                char* out = segment->base;
+                if (out != nullptr) {
+                    std::memcpy(out + position, prefix, prefixLength);
+                    std::memcpy(out + position + prefixLength, text, length);
+                    if (newline) out[position + size - 1] = '\n';
+                }
+                settle(*segment, size);
+                return;
+            }
+            // Does not fit: the straddling reservation marks the end of the data
+            if (position < segment->capacity) {
+                segment->dataEnd.store(position, std::memory_order_release);
+                settle(*segment, segment->capacity - position);
+            }
+            rollover(segment);
+        }
+    }
+
+public:
+    explicit MmapLogWriter(const MmapLogConfig& cfg) : config(cfg) {
+        recoverPreviousRun();
+        current.store(openSegment(), std::memory_order_release);
+        const char start[] = "=== PROGRAM START ===\n";
+        reserveAndCopy(start, sizeof(start) - 1, "", 0, false);
+    }
+
+    MmapLogWriter(const MmapLogWriter&) = delete;
+    MmapLogWriter& operator=(const MmapLogWriter&) = delete;
+
+    // Writes prefix + text + '\n' as one line (also for empty text); safe to
+    // call from any number of threads
+    void append(const char* prefix, std::size_t prefixLength, const char* text, std::size_t length) {
+        reserveAndCopy(prefix, prefixLength, text, length, true);
+    }
+
+    void append(const char* text, std::size_t length) { append("[LOG] ", 6, text, length); }
+
+    // Forces the mapped pages of the current segment to disk (not needed for process crashes)
+    void syncToDisk() {
+        Segment* segment = current.load(std::memory_order_acquire);
+        if (segment->base != nullptr) ::msync(segment->base, segment->capacity, MS_SYNC);
+    }
+
+    const MmapLogRecovery& recovery() const { return recovered; }
+    std::size_t segmentCount() const { return segments.size(); }
+
+    // Producers must be done: the last segment is closed at its real length
+    ~MmapLogWriter() {
+        const char end[] = "=== PROGRAM END ===\n";
+        reserveAndCopy(end, sizeof(end) - 1, "", 0, false);
+        Segment* last = current.load(std::memory_order_acquire);
+        last->dataEnd.store(std::min(last->cursor.load(), last->capacity), std::memory_order_release);
+        if (last->base != nullptr || last->fd >= 0) closeSegment(*last);
+    }
+};
@@ -1,17 +1,29 @@
-#include <iostream>
 #include <vector>
 #include <string>
 
+#include "fast_format.h"
+
+#ifdef LEAN_OUTPUT
+#include "lean_out.h"   // io::cout without <iostream> (lean build, see CMakeLists.txt)
+namespace io = lean;
+#else
+#include <iostream>
+namespace io = std;
+#endif
+
 int main() {
-    std::cout << "Hello C++ World!" << std::endl;
-    std::cout << "Testing basic C++ features..." << std::endl;
+    io::cout << "Hello C++ World!" << io::endl;
+    io::cout << "Testing basic C++ features..." << io::endl;
     
     std::vector<int> numbers = {1, 2, 3, 4, 5};
-    std::cout << "Vector contents: ";
+    // One buffer and one fwrite for the whole line instead of a
+    // locale-aware operator<< per element
+    FormatBuffer out;
+    out.append("Vector contents: ");
     for (int num : numbers) {
-        std::cout << num << " ";
+        out.append(num).append(' ');
     }
-    std::cout << std::endl;
+    out.append('\n').flush();
     
     return 0;
 }
\ No newline at end of file
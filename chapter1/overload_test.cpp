@@ -16,32 +16,38 @@ OVERLOAD RESOLUTION RULES (C++ Standard):
 ===============================================================================
 */
 
-#include <iostream>
+#include <array>
+#include <span>
 #include <vector>
 
+#include "alloc_counter.h"     // Counts every heap allocation of this program
+#include "print_overloads.h"   // print(int), print(vector), print(span), print(int[N])
+
+#ifdef LEAN_OUTPUT
+#include "lean_out.h"   // io::cout without <iostream> (lean build, see CMakeLists.txt)
+namespace io = lean;
+#else
+#include <iostream>
+namespace io = std;
+#endif
+
 /*
 ===============================================================================
-FUNCTION OVERLOADS - Two candidates for the same call
+FUNCTION OVERLOADS - Candidates for the same call (see print_overloads.h)
+===============================================================================
+print(int)                          exact match for int
+print(const std::vector<int>&)      vectors, no copy
+print(std::span<const int>)         any contiguous ints
+template <size_t N> print(const int (&)[N])   braced lists, no heap
 ===============================================================================
 */
 
-// OVERLOAD 1: Takes a single integer by value
-// CONVERSION RANKING: Exact match for int arguments
-// PERFORMANCE: No construction needed - just copy the integer
-void print(int x) {
-    // This function is the "winner" for single-element initializer lists
-    // because {2} -> int is a STANDARD conversion (better ranking)
-    std::cout << "print(int): " << x << std::endl;
-}
-
-// OVERLOAD 2: Takes a vector of integers by value
-// CONVERSION RANKING: Requires user-defined construction
-// PERFORMANCE: Needs to construct vector object (more expensive)
-// NOTE: Could be optimized to const std::vector<int>& for better performance
-void print(const std::vector<int> n) {
-    // This function "loses" for {2} because {2} -> vector<int> 
-    // is a USER-DEFINED conversion (worse ranking)
-    std::cout << "print(vector) <int>" << std::endl;
+// Runs one call and reports how many heap allocations it caused
+template <typename Call>
+void countAllocations(Call&& call) {
+    std::size_t before = allocationCount();
+    call();
+    io::cout << "  heap allocations: " << allocationCount() - before << io::endl;
 }
 
 /*
@@ -60,7 +66,7 @@ int main() {
     REASONING: Exact match - no conversion needed
     ===============================================================================
     */
-    std::cout << "=== TEST 1: Direct integer ===" << std::endl;
+    io::cout << "=== TEST 1: Direct integer ===" << io::endl;
     print(2);                    // Obvious choice: print(int) - exact match
     
     /*
@@ -72,9 +78,9 @@ int main() {
     REASONING: Type already matches exactly - no conversion needed
     ===============================================================================
     */
-    std::cout << "\n=== TEST 2: Pre-constructed vector ===" << std::endl;
+    io::cout << "\n=== TEST 2: Pre-constructed vector ===" << io::endl;
     std::vector<int> v = {2};    // Vector created first, then passed
-    print(v);                    // Type matches print(vector) exactly
+    countAllocations([&] { print(v); });   // Type matches print(vector) exactly - no copy
     
     /*
     ===============================================================================
@@ -85,8 +91,8 @@ int main() {
     REASONING: Explicit type removes all ambiguity
     ===============================================================================
     */
-    std::cout << "\n=== TEST 3: Explicit vector construction ===" << std::endl;
-    print(std::vector<int>{2});  // Forces vector constructor - no ambiguity
+    io::cout << "\n=== TEST 3: Explicit vector construction ===" << io::endl;
+    countAllocations([] { print(std::vector<int>{2}); });  // Forces vector constructor - 1 allocation
     
     /*
     ===============================================================================
@@ -113,9 +119,33 @@ int main() {
     COMPILER DECISION: Choose Option A (standard conversion beats user-defined)
     ===============================================================================
     */
-    std::cout << "\n=== TEST 4: Surprising single-element initializer ===" << std::endl;
+    io::cout << "\n=== TEST 4: Surprising single-element initializer ===" << io::endl;
     print({2});                   // Calls print(int)! Not print(vector) as many expect
     
+    /*
+    ===============================================================================
+    TEST CASE 5: Multi-element initializer list - the zero-copy way
+    ===============================================================================
+    CALL: print({2, 2})
+    EXPECTED: print(int[N]) overload
+    REASONING: {2, 2} cannot become an int; binding it to const int (&)[2] is an
+               identity conversion and beats the user-defined vector conversion.
+               The list lives in a temporary array on the stack - no heap.
+    ===============================================================================
+    */
+    io::cout << "\n=== TEST 5: Multi-element initializer list ===" << io::endl;
+    countAllocations([] { print({2, 2}); });
+    
+    /*
+    ===============================================================================
+    TEST CASE 6: Any contiguous range through std::span
+    ===============================================================================
+    */
+    io::cout << "\n=== TEST 6: std::array and sub-ranges via span ===" << io::endl;
+    std::array<int, 4> a = {1, 2, 3, 4};
+    countAllocations([&] { print(std::span<const int>(a)); });
+    countAllocations([&] { print(std::span<const int>(a).subspan(1, 2)); });
+    
     /*
     ===============================================================================
     UNDERSTANDING THE COMPILER WARNING:
@@ -147,17 +177,18 @@ int main() {
                                    // inner braces for initializer_list
     
     METHOD 3: Remove ambiguity with multiple elements  
-    print({2, 2});                // Cannot convert to single int, must be vector
+    print({2, 2});                // Cannot convert to single int: print(int[N])
     
     METHOD 4: Use std::initializer_list parameter (API design solution)
-    void print(std::initializer_list<int> list); // Better for this use case
+    void print(std::initializer_list<int> list); // CAREFUL: this one also wins
+                                  // print({2}), see print_overloads.h
     ===============================================================================
     */
     
-    std::cout << "\n=== SUMMARY ===" << std::endl;
-    std::cout << "The key lesson: C++ overload resolution follows strict" << std::endl;
-    std::cout << "conversion ranking rules, not programmer intuition!" << std::endl;
-    std::cout << "Standard conversions beat user-defined conversions." << std::endl;
+    io::cout << "\n=== SUMMARY ===" << io::endl;
+    io::cout << "The key lesson: C++ overload resolution follows strict" << io::endl;
+    io::cout << "conversion ranking rules, not programmer intuition!" << io::endl;
+    io::cout << "Standard conversions beat user-defined conversions." << io::endl;
     
     return 0;
 }
@@ -170,6 +201,7 @@ LESSONS LEARNED:
 3. C++ prefers standard conversions over user-defined constructors
 4. Be explicit when you want container construction from single elements
 5. This behavior applies to all container types, not just vector
+6. Pass containers by const& or std::span - by value copies and allocates
 
 PRACTICAL IMPLICATIONS:
 - API design should consider this ambiguity
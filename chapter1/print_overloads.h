@@ -0,0 +1,78 @@
+/*
+===============================================================================
+TITLE: print() overload family used by overload_test.cpp
+TOPIC: Zero-copy range overloads that keep the original resolution rules
+
+    print(2)                   -> print(int)
+    print({2})                 -> print(int)          (unchanged, see below)
+    print(v)                   -> print(vector)       by const&, no copy
+    print(std::vector<int>{2}) -> print(vector)
+    print({2, 2})              -> print(int[N])       stack array, no heap
+    print(std::span(...))      -> print(span)         any contiguous ints
+
+WHY NOT print(std::initializer_list<int>)?
+- [over.ics.rank]/3.1: a list conversion to std::initializer_list<X> is
+  BETTER than any other list conversion of the same rank
+- {2} -> initializer_list<int> would therefore beat {2} -> int and silently
+  steal print({2}) from print(int)
+- const int (&)[N] also binds a braced list to a temporary array without any
+  allocation, but it is a template: when {2} -> int and {2} -> int[1] tie,
+  the non-template print(int) wins, exactly as before
+
+BUFFERED OUTPUT (fast_format.h):
+- Every overload formats its whole line into a reusable per-thread
+  FormatBuffer with digit-pair integer formatting and writes it with one
+  fwrite - no operator<< per element, no locale, no std::endl flush
+- stdout is shared with std::cout (sync_with_stdio), so lines still appear
+  in program order between the test's own std::cout output
+===============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include "fast_format.h"
+
+// OVERLOAD 1: Takes a single integer by value
+// CONVERSION RANKING: Exact match for int arguments
+// PERFORMANCE: No construction needed - just copy the integer
+inline void print(int x) {
+    // This function is the "winner" for single-element initializer lists
+    // because {2} -> int is a STANDARD conversion (better ranking)
+    stdoutBuffer().append("print(int): ").append(x).append('\n').flush();
+}
+
+// Formats "label: e0 e1 ...\n" into the thread's FormatBuffer; large ranges go out in 64 KB chunks
+inline void writeRange(const char* label, std::span<const int> values) {
+    FormatBuffer& out = stdoutBuffer();
+    out.append(label).append(':');
+    for (int value : values) out.append(' ').append(value);
+    out.append('\n').flush();
+}
+
+// OVERLOAD 2: Takes a vector of integers by const reference
+// CONVERSION RANKING: Requires user-defined construction for braced lists
+// PERFORMANCE: Was by value (copy + heap allocation per call); now binds
+//              directly to the caller's vector
+inline void print(const std::vector<int>& n) {
+    // This function "loses" for {2} because {2} -> vector<int>
+    // is a USER-DEFINED conversion (worse ranking)
+    writeRange("print(vector) <int>", n);
+}
+
+// OVERLOAD 3: Any contiguous run of ints (std::array, part of a vector, ...)
+// CONVERSION RANKING: User-defined (span constructor) - never beats 1, 2 or 4
+inline void print(std::span<const int> values) {
+    writeRange("print(span) <int>", values);
+}
+
+// OVERLOAD 4: Braced lists of two or more ints, e.g. print({2, 2})
+// CONVERSION RANKING: Identity, but a template - loses ties against print(int)
+// PERFORMANCE: The list becomes a temporary array on the stack, no heap
+template <std::size_t N>
+void print(const int (&values)[N]) {
+    writeRange("print(int[N]) <int>", values);
+}
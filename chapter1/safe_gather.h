@@ -0,0 +1,178 @@
+/*
+===============================================================================
+TITLE: Branch-free bulk bounds-checked gather
+TOPIC: Validate many a[base + off] lookups at once with SIMD compares
+
+For every element i the kernels compute index = base[i] + off[i] and decide
+validity WITHOUT a branch:
+- overflow  : base + off does not fit in int (sign trick below)
+- in range  : 0 <= index < size
+- valid     : !overflow && in range
+Results:
+- out[i]  = a[index] when valid, 0 otherwise
+- mask    : bit i of mask[i / 64] is set when element i is valid
+- return  : number of valid elements
+
+KERNELS:
+- gatherScalar : portable, one element per step, still branch-free
+- gatherSse2   : 4 lanes of compares, scalar loads from clamped indices
+- gatherAvx2   : 8 lanes of compares + masked hardware gather (-mavx2)
+- gatherBest   : the widest kernel the build targets
+
+OVERFLOW TRICK: with wrapping addition s = b + o, signed overflow happened
+exactly when b and o have the same sign and s has the other one:
+    ((b ^ s) & (o ^ s)) < 0
+===============================================================================
+*/
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Words of validity mask needed for n elements
+constexpr std::size_t gatherMaskWords(std::size_t n) { return (n + 63) / 64; }
+
+// Sizes beyond INT_MAX cannot be reached by an int index anyway
+inline int clampGatherSize(std::size_t size) {
+    return size > static_cast<std::size_t>(INT_MAX) ? INT_MAX : static_cast<int>(size);
+}
+
+// Shared by the kernels for the elements that do not fill a whole vector
+inline std::size_t gatherScalarRange(const int* a, int size, const int* bases, const int* offs,
+                                     int* out, std::uint64_t* mask, std::size_t first, std::size_t last) {
+    std::size_t valid = 0;
+    std::uint64_t bits = 0;                       // Mask word being built, stored every 64 elements
+    for (std::size_t i = first; i < last; ++i) {
+        // Unsigned addition wraps instead of being undefined behaviour
+        int index = static_cast<int>(static_cast<unsigned>(bases[i]) + static_cast<unsigned>(offs[i]));
+        bool overflow = ((bases[i] ^ index) & (offs[i] ^ index)) < 0;
+        bool ok = !overflow & (index >= 0) & (index < size);
+        out[i] = a[ok ? index : 0] & -static_cast<int>(ok);
+        bits |= static_cast<std::uint64_t>(ok) << (i % 64);
+        valid += ok;
+        if (i % 64 == 63) {
+            mask[i / 64] |= bits;
+            bits = 0;
+        }
+    }
+    if (last % 64 != 0) mask[last / 64] |= bits;
+    return valid;
+}
+
+inline std::size_t gatherScalar(const int* a, std::size_t size, const int* bases, const int* offs,
+                                int* out, std::uint64_t* mask, std::size_t n) {
+    std::memset(mask, 0, gatherMaskWords(n) * sizeof(std::uint64_t));
+    if (a == nullptr || size == 0) {
+        std::memset(out, 0, n * sizeof(int));
+        return 0;
+    }
+    return gatherScalarRange(a, clampGatherSize(size), bases, offs, out, mask, 0, n);
+}
+
+#if defined(__SSE2__)
+inline std::size_t gatherSse2(const int* a, std::size_t size, const int* bases, const int* offs,
+                              int* out, std::uint64_t* mask, std::size_t n) {
+    std::memset(mask, 0, gatherMaskWords(n) * sizeof(std::uint64_t));
+    if (a == nullptr || size == 0) {
+        std::memset(out, 0, n * sizeof(int));
+        return 0;
+    }
+    const int limit = clampGatherSize(size);
+    const __m128i vsize = _mm_set1_epi32(limit);
+    const __m128i minusOne = _mm_set1_epi32(-1);
+    std::size_t valid = 0;
+    std::size_t i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bases + i));
+        __m128i o = _mm_loadu_si128(reinterpret_cast<const __m128i*>(offs + i));
+        __m128i s = _mm_add_epi32(b, o);
+        __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(b, s), _mm_xor_si128(o, s)), 31);
+        __m128i inRange = _mm_and_si128(_mm_cmpgt_epi32(s, minusOne), _mm_cmplt_epi32(s, vsize));
+        __m128i ok = _mm_andnot_si128(overflow, inRange);
+
+        // Invalid lanes read a[0] and are masked to zero - no branch per element
+        alignas(16) int index[4];
+        alignas(16) int keep[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(index), _mm_and_si128(s, ok));
+        _mm_store_si128(reinterpret_cast<__m128i*>(keep), ok);
+        out[i + 0] = a[index[0]] & keep[0];
+        out[i + 1] = a[index[1]] & keep[1];
+        out[i + 2] = a[index[2]] & keep[2];
+        out[i + 3] = a[index[3]] & keep[3];
+
+        unsigned bits = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(ok)));
+        mask[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64);
+        valid += static_cast<std::size_t>(__builtin_popcount(bits));
+    }
+    return valid + gatherScalarRange(a, limit, bases, offs, out, mask, i, n);
+}
+#endif
+
+#if defined(__AVX2__)
+inline std::size_t gatherAvx2(const int* a, std::size_t size, const int* bases, const int* offs,
+                              int* out, std::uint64_t* mask, std::size_t n) {
+    std::memset(mask, 0, gatherMaskWords(n) * sizeof(std::uint64_t));
+    if (a == nullptr || size == 0) {
+        std::memset(out, 0, n * sizeof(int));
+        return 0;
+    }
+    const int limit = clampGatherSize(size);
+    const __m256i vsize = _mm256_set1_epi32(limit);
+    const __m256i minusOne = _mm256_set1_epi32(-1);
+    const __m256i zero = _mm256_setzero_si256();
+    std::size_t valid = 0;
+    std::size_t i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bases + i));
+        __m256i o = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offs + i));
+        __m256i s = _mm256_add_epi32(b, o);
+        __m256i overflow = _mm256_srai_epi32(_mm256_and_si256(_mm256_xor_si256(b, s), _mm256_xor_si256(o, s)), 31);
+        __m256i inRange = _mm256_and_si256(_mm256_cmpgt_epi32(s, minusOne), _mm256_cmpgt_epi32(vsize, s));
+        __m256i ok = _mm256_andnot_si256(overflow, inRange);
+
+        // Masked-off lanes are not loaded at all and stay zero
+        __m256i values = _mm256_mask_i32gather_epi32(zero, a, s, ok, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), values);
+
+        unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(ok)));
+        mask[i / 64] |= static_cast<std::uint64_t>(bits) << (i % 64);
+        valid += static_cast<std::size_t>(__builtin_popcount(bits));
+    }
+    return valid + gatherScalarRange(a, limit, bases, offs, out, mask, i, n);
+}
+#endif
+
+inline std::size_t gatherBest(const int* a, std::size_t size, const int* bases, const int* offs,
+                              int* out, std::uint64_t* mask, std::size_t n) {
+#if defined(__AVX2__)
+    return gatherAvx2(a, size, bases, offs, out, mask, n);
+#elif defined(__SSE2__)
+    return gatherSse2(a, size, bases, offs, out, mask, n);
+#else
+    return gatherScalar(a, size, bases, offs, out, mask, n);
+#endif
+}
+
+// Index of the first element whose mask bit is clear, or n if all are valid
+inline std::size_t firstInvalid(const std::uint64_t* mask, std::size_t n) {
+    for (std::size_t word = 0; word < gatherMaskWords(n); ++word) {
+        std::uint64_t missing = ~mask[word];
+        if (missing != 0) {
+            std::size_t index = word * 64 + static_cast<std::size_t>(__builtin_ctzll(missing));
+            return index < n ? index : n;
+        }
+    }
+    return n;
+}
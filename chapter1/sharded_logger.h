@@ -0,0 +1,226 @@
+/*
+===============================================================================
+TITLE: Per-thread sharded Logger with timestamp-ordered merge
+TOPIC: Thread-safe logging without a shared lock on the hot path
+
+WHY NOT A MUTEX AROUND Logger?
+- Every thread calling processCriticalData would queue up on the same lock
+  and the same ofstream - logging would serialize the whole program
+
+SHARDING:
+- Each thread gets its own shard on first use: a private buffer plus its
+  own segment file (debug_log.txt.shard<N>)
+- log() stamps the record with steady_clock (monotonic, comparable across
+  threads), appends it to the thread's buffer and only calls write() when
+  the buffer is full - no lock, no shared cache line
+- The only lock is taken once per thread, when its shard is created
+
+MERGE:
+- merge() (also run by the destructor) flushes every shard, then performs a
+  k-way merge by (timestamp, shard) into one debug_log.txt with
+  the usual "[LOG] ..." lines, and removes the segment files
+- Call it only after the logging threads have finished; merge() is final,
+  do not log through the same ShardedLogger afterwards
+
+SEGMENT RECORD LAYOUT (host byte order):
+    i64 timestamp   u32 length   bytes[length]
+===============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "log_levels.h"
+
+class ShardedLogger {
+private:
+    struct Shard {
+        std::string path;
+        int fd;
+        std::vector<char> buffer;
+        std::size_t used = 0;
+
+        Shard(std::string segmentPath, std::size_t bufferBytes)
+            : path(std::move(segmentPath)),
+              fd(::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644)),
+              buffer(bufferBytes) {}
+
+        void flush() {
+            const char* data = buffer.data();
+            while (used > 0) {
+                ssize_t written = ::write(fd, data, used);
+                if (written <= 0) break;
+                data += written;
+                used -= static_cast<std::size_t>(written);
+            }
+            used = 0;
+        }
+
+        void append(std::int64_t timestamp, const char* text, std::uint32_t length) {
+            std::size_t size = sizeof(timestamp) + sizeof(length) + length;
+            if (buffer.size() - used < size) flush();
+            if (buffer.size() < size) buffer.resize(size);
+            char* out = buffer.data() + used;
+            std::memcpy(out, &timestamp, sizeof(timestamp));
+            std::memcpy(out + sizeof(timestamp), &length, sizeof(length));
+            std::memcpy(out + sizeof(timestamp) + sizeof(length), text, length);
+            used += size;
+        }
+
+        ~Shard() {
+            flush();
+            if (fd >= 0) ::close(fd);
+        }
+    };
+
+    // Each thread remembers the shard it owns in every logger it has used.
+    // owner is unique per logger, so a new logger at a reused address never
+    // matches an old entry; alive is shared with the logger and cleared by
+    // merge(), which lets a thread drop entries of finished loggers
+    struct CachedShard {
+        std::uint64_t owner;
+        std::shared_ptr<const std::atomic<bool>> alive;
+        Shard* shard;
+    };
+
+    static std::uint64_t nextLoggerId() {
+        static std::atomic<std::uint64_t> counter{0};
+        return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+
+    static std::vector<CachedShard>& threadCache() {
+        thread_local std::vector<CachedShard> cache;
+        return cache;
+    }
+
+    std::string path;
+    std::size_t bufferBytes;
+    std::uint64_t id = nextLoggerId();
+    std::shared_ptr<std::atomic<bool>> alive = std::make_shared<std::atomic<bool>>(true);
+    std::mutex registryLock;                     // Only taken when a thread creates its shard
+    std::vector<std::unique_ptr<Shard>> shards;
+    bool merged = false;
+
+    Shard& localShard() {
+        std::vector<CachedShard>& cache = threadCache();
+        for (const CachedShard& entry : cache) {
+            if (entry.owner == id) return *entry.shard;
+        }
+
+        // Miss: evict entries of merged or destroyed loggers before growing
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < cache.size(); ++i) {
+            if (cache[i].alive->load(std::memory_order_acquire)) cache[kept++] = std::move(cache[i]);
+        }
+        cache.erase(cache.begin() + static_cast<std::ptrdiff_t>(kept), cache.end());
+
+        std::lock_guard<std::mutex> guard(registryLock);
+        std::string segment = path + ".shard" + std::to_string(shards.size());
+        shards.emplace_back(new Shard(segment, bufferBytes));
+        cache.push_back(CachedShard{id, alive, shards.back().get()});
+        return *shards.back();
+    }
+
+    struct SegmentReader {
+        std::ifstream in;
+        std::int64_t timestamp = 0;
+        std::string text;
+
+        explicit SegmentReader(const std::string& segment) : in(segment, std::ios::binary) {}
+
+        bool next() {
+            std::uint32_t length = 0;
+            if (!in.read(reinterpret_cast<char*>(&timestamp), sizeof(timestamp))) return false;
+            if (!in.read(reinterpret_cast<char*>(&length), sizeof(length))) return false;
+            text.resize(length);
+            return static_cast<bool>(in.read(&text[0], length));
+        }
+    };
+
+public:
+    explicit ShardedLogger(const char* outputPath = "debug_log.txt", std::size_t shardBufferBytes = 64 * 1024)
+        : path(outputPath), bufferBytes(shardBufferBytes) {}
+
+    ShardedLogger(const ShardedLogger&) = delete;
+    ShardedLogger& operator=(const ShardedLogger&) = delete;
+
+    void log(const char* message, std::size_t length) {
+        std::int64_t timestamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        localShard().append(timestamp, message, static_cast<std::uint32_t>(length));
+    }
+
+    void log(const char* message) { log(message, std::strlen(message)); }
+    void log(const std::string& message) { log(message.data(), message.size()); }
+
+    template <typename... Args>
+    void logf(const LogFormat& format, const Args&... args) {
+        char line[kLogLineText];
+        LogLineBuilder builder{line, sizeof(line)};
+        const char* rest = format.text;
+        builder.format(rest, args...);
+        log(line, builder.length);
+    }
+
+    // K-way merge of all segments into one time-ordered log file
+    void merge() {
+        std::lock_guard<std::mutex> guard(registryLock);
+        if (merged) return;
+        merged = true;
+
+        std::vector<std::unique_ptr<SegmentReader>> readers;
+        for (std::unique_ptr<Shard>& shard : shards) {
+            shard->flush();
+            readers.emplace_back(new SegmentReader(shard->path));
+        }
+
+        // Min-heap on (timestamp, shard); records inside one shard are already in order
+        typedef std::pair<std::int64_t, std::size_t> Head;
+        std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+        for (std::size_t i = 0; i < readers.size(); ++i) {
+            if (readers[i]->next()) heads.push(Head(readers[i]->timestamp, i));
+        }
+
+        std::ofstream out(path);
+        out << "=== PROGRAM START ===\n";
+        while (!heads.empty()) {
+            std::size_t i = heads.top().second;
+            heads.pop();
+            out << "[LOG] " << readers[i]->text << '\n';
+            if (readers[i]->next()) heads.push(Head(readers[i]->timestamp, i));
+        }
+        out << "=== PROGRAM END ===\n";
+
+        readers.clear();
+        for (std::unique_ptr<Shard>& shard : shards) std::remove(shard->path.c_str());
+        shards.clear();
+        alive->store(false, std::memory_order_release);
+    }
+
+    ~ShardedLogger() { merge(); }
+};
+
+// Lets StaticLogger<Level, ShardedSink> use sharded storage
+struct ShardedSink {
+    ShardedLogger& logger;
+
+    template <typename... Args>
+    void write(LogLevel, const LogFormat& format, const Args&... args) {
+        logger.logf(format, args...);
+    }
+};
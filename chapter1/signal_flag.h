@@ -0,0 +1,179 @@
+/*
+===============================================================================
+TITLE: Cross-thread flags and pointer publication without volatile
+TOPIC: What `volatile` is NOT for (see HW1_1_solution.cpp)
+
+    SignalFlag ready;                       Publication<Config> config;
+    // thread A                             // writer
+    ready.set();                            config.publish(new Config{...});
+    // thread B                             // readers
+    ready.wait();                           const Config* c = config.wait();
+
+WHY NOT volatile?
+- volatile only stops the compiler from caching or dropping the access. It
+  orders nothing: neither the compiler nor the CPU has to keep the writes
+  made BEFORE `flag = 1` ahead of it, so the waiting thread can see the
+  flag and still read stale data. Two threads touching the same volatile
+  int is a data race - undefined behavior
+- volatile is right for memory-mapped I/O and for `volatile std::sig_atomic_t`
+  shared with a signal handler on the SAME thread - the HW1_1 cases
+- A spinning `while (!flag) {}` also burns a core; on a machine with fewer
+  free cores than spinners it waits for the OS to preempt the spinner
+
+MEMORY ORDERS (every access says which one it needs):
+- set()/publish() store with RELEASE: everything written before is visible
+  to whoever observes the flag or pointer with ACQUIRE
+- wait()/isSet()/tryAcquire() load with ACQUIRE
+- clear() is RELAXED: it publishes nothing, the next set() does
+
+WAITING (spin, then futex):
+- wait() spins a bounded number of times (cheap when the signal is close;
+  no spinning at all on a single core, where the setter cannot run meanwhile),
+  then sleeps in the kernel on the flag word itself: futex(FUTEX_WAIT) on
+  Linux, std::atomic::wait elsewhere
+- set() only makes the wake-up system call when a waiter announced itself
+  (state ClearWaiting), so an uncontended set() is one atomic exchange
+- The state word is a lock-free std::atomic<std::uint32_t>, and futex wake
+  is a plain system call: set() may be called from a signal handler
+
+benchmarks/signal_bench.cpp: wake-up latency and hand-offs per second of
+volatile spinning, atomic spinning, SignalFlag and mutex + condvar.
+===============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Tells the core (and a hyper-thread sibling) that this is a spin loop
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+/*
+===============================================================================
+FUTEX - sleep until a 32-bit word changes
+===============================================================================
+*/
+
+static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t) &&
+                  std::atomic<std::uint32_t>::is_always_lock_free,
+              "futex needs the atomic to be the plain 32-bit word");
+
+// Returns at once if word != expected; may also return spuriously
+inline void futexWait(std::atomic<std::uint32_t>& word, std::uint32_t expected) {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    word.wait(expected, std::memory_order_acquire);
+#endif
+}
+
+inline void futexWakeAll(std::atomic<std::uint32_t>& word) {
+#if defined(__linux__)
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    word.notify_all();
+#endif
+}
+
+/*
+===============================================================================
+SIGNAL FLAG
+===============================================================================
+*/
+
+class SignalFlag {
+private:
+    enum State : std::uint32_t { Clear = 0, Set = 1, ClearWaiting = 2 };
+
+    std::atomic<std::uint32_t> state{Clear};
+
+public:
+    // Spinning only helps when the setter runs on another core at the same time
+    static unsigned defaultSpins() {
+        static const unsigned spins = std::thread::hardware_concurrency() > 1 ? 64 : 0;
+        return spins;
+    }
+
+    SignalFlag() = default;
+    SignalFlag(const SignalFlag&) = delete;
+    SignalFlag& operator=(const SignalFlag&) = delete;
+
+    void set() noexcept {
+        if (state.exchange(Set, std::memory_order_release) == ClearWaiting) futexWakeAll(state);
+    }
+
+    bool isSet() const noexcept { return state.load(std::memory_order_acquire) == Set; }
+
+    // Only Set -> Clear: a waiter's ClearWaiting mark must survive
+    void clear() noexcept {
+        std::uint32_t expected = Set;
+        state.compare_exchange_strong(expected, Clear, std::memory_order_relaxed);
+    }
+
+    void wait() noexcept { wait(defaultSpins()); }
+
+    void wait(unsigned spins) noexcept {
+        for (unsigned i = 0; i < spins; ++i) {
+            if (state.load(std::memory_order_acquire) == Set) return;
+            cpuRelax();
+        }
+        for (;;) {
+            std::uint32_t current = state.load(std::memory_order_acquire);
+            if (current == Set) return;
+            // Announce the sleeper, so that set() knows it has to wake somebody
+            if (current == Clear &&
+                !state.compare_exchange_weak(current, ClearWaiting, std::memory_order_acquire)) {
+                continue;
+            }
+            futexWait(state, ClearWaiting);
+        }
+    }
+};
+
+/*
+===============================================================================
+POINTER PUBLICATION - build an object, then hand it over in one store
+===============================================================================
+*/
+
+template <typename T>
+class Publication {
+private:
+    std::atomic<T*> value{nullptr};
+    SignalFlag published;
+
+public:
+    // Everything written to *object before this call is visible to readers
+    void publish(T* object) noexcept {
+        value.store(object, std::memory_order_release);
+        published.set();
+    }
+
+    // nullptr until published, never blocks
+    T* tryAcquire() const noexcept { return value.load(std::memory_order_acquire); }
+
+    T* wait() noexcept {
+        if (T* object = tryAcquire()) return object;
+        published.wait();
+        return tryAcquire();
+    }
+};
@@ -0,0 +1,177 @@
+/*
+===============================================================================
+TITLE: Type names without RTTI lookups or repeated demangling
+TOPIC: What HW1_2 prints with typeid(...).name(), readable and cheap
+
+    typeName<decltype(var)>()         // "int" - constexpr, no RTTI at all
+    demangledName(typeid(*object))    // "Derived" - dynamic type, demangled once
+
+typeid(x).name() returns the MANGLED name ("i", "M9TestClassFvvE") and
+turning it into "int" with abi::__cxa_demangle costs a parse plus a malloc
+on every call - too slow for a diagnostics hot path.
+
+COMPILE TIME (typeName<T>):
+- Inside a function template, __PRETTY_FUNCTION__ (GCC, Clang) or
+  __FUNCSIG__ (MSVC) spells out the template argument:
+      GCC   : "... typeName() [with T = int; std::string_view = ...]"
+      Clang : "... typeName() [T = int]"
+      MSVC  : "... typeName<int>(void)"
+- Cutting out the argument is constexpr, so the name is a string_view into
+  a string literal in the binary: no allocation, no lookup, no runtime cost
+- Only works for static types; the spelling follows the compiler (GCC says
+  "std::__cxx11::basic_string<char>" where Clang says "std::string")
+
+RUN TIME (demangledName):
+- For dynamic types (typeid of a polymorphic object) there is no way around
+  std::type_info, but the demangling only has to happen ONCE per type
+- The cache interns each demangled name keyed by the type_info's name()
+  pointer. Each thread keeps a small direct-mapped front cache of recent
+  hits, so a repeated lookup takes no lock at all; misses there take a
+  shared lock. The returned string_view stays valid for the rest of the
+  program
+
+benchmarks/type_name_bench.cpp compares both against typeid().name() plus
+__cxa_demangle on every call.
+===============================================================================
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <unordered_map>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#define TYPE_NAME_HAS_CXXABI 1
+#endif
+
+/*
+===============================================================================
+COMPILE-TIME NAMES
+===============================================================================
+*/
+
+namespace type_name_detail {
+
+template <typename T>
+constexpr std::string_view rawSignature() {
+#if defined(__clang__) || defined(__GNUC__)
+    return __PRETTY_FUNCTION__;
+#elif defined(_MSC_VER)
+    return __FUNCSIG__;
+#else
+    return "";
+#endif
+}
+
+// Cuts the template argument out of rawSignature<T>()
+constexpr std::string_view extract(std::string_view signature) {
+#if defined(__clang__) || defined(__GNUC__)
+    std::size_t start = signature.find("T = ");
+    if (start == std::string_view::npos) return signature;
+    start += 4;
+    // GCC appends "; std::string_view = ..." after the argument, Clang just "]"
+    std::size_t end = signature.find(';', start);
+    if (end == std::string_view::npos) end = signature.rfind(']');
+    return signature.substr(start, end - start);
+#elif defined(_MSC_VER)
+    std::size_t start = signature.find("rawSignature<");
+    std::size_t end = signature.rfind(">(void)");
+    if (start == std::string_view::npos || end == std::string_view::npos) return signature;
+    start += 13;
+    return signature.substr(start, end - start);
+#else
+    return signature;
+#endif
+}
+
+}  // namespace type_name_detail
+
+template <typename T>
+constexpr std::string_view typeName() {
+    // A constexpr local forces the parsing to happen during compilation
+    constexpr std::string_view name = type_name_detail::extract(type_name_detail::rawSignature<T>());
+    return name;
+}
+
+/*
+===============================================================================
+RUNTIME DEMANGLE CACHE
+===============================================================================
+*/
+
+// The slow path: one full demangle, as typeid(...).name() users write it
+inline std::string demangle(const char* mangled) {
+#ifdef TYPE_NAME_HAS_CXXABI
+    int status = 0;
+    std::unique_ptr<char, void (*)(void*)> readable(abi::__cxa_demangle(mangled, nullptr, nullptr, &status),
+                                                    std::free);
+    if (status == 0 && readable) return readable.get();
+#endif
+    return mangled;   // MSVC's name() is already readable
+}
+
+class DemangleCache {
+private:
+    std::shared_mutex lock;
+    // Keyed by the name() pointer: one std::type_info object per type in
+    // practice, and a pointer hashes far faster than the string behind it
+    std::unordered_map<const char*, std::unique_ptr<const std::string>> names;
+
+    // Per-thread, lock-free: interned names never move, so views stay valid
+    static constexpr std::size_t kFrontEntries = 16;   // Slot: top 4 bits of a multiplicative hash
+    struct FrontEntry {
+        const char* mangled = nullptr;
+        std::string_view readable;
+    };
+
+    static FrontEntry* frontCache() {
+        thread_local FrontEntry entries[kFrontEntries];
+        return entries;
+    }
+
+    std::string_view lookup(const char* mangled) {
+        {
+            std::shared_lock<std::shared_mutex> guard(lock);
+            auto found = names.find(mangled);
+            if (found != names.end()) return *found->second;
+        }
+        std::unique_ptr<const std::string> readable(new std::string(demangle(mangled)));   // Outside the lock
+        std::unique_lock<std::shared_mutex> guard(lock);
+        auto inserted = names.emplace(mangled, std::move(readable));
+        return *inserted.first->second;
+    }
+
+    DemangleCache() = default;
+
+public:
+    static DemangleCache& instance() {
+        static DemangleCache cache;
+        return cache;
+    }
+
+    std::string_view name(const std::type_info& type) {
+        const char* mangled = type.name();
+        std::size_t slot = static_cast<std::size_t>((reinterpret_cast<std::uintptr_t>(mangled) * 0x9e3779b97f4a7c15ull) >> 60);
+        FrontEntry& front = frontCache()[slot];
+        if (front.mangled == mangled) return front.readable;
+
+        std::string_view readable = lookup(mangled);
+        front = FrontEntry{mangled, readable};
+        return readable;
+    }
+
+    std::size_t size() {
+        std::shared_lock<std::shared_mutex> guard(lock);
+        return names.size();
+    }
+};
+
+inline std::string_view demangledName(const std::type_info& type) { return DemangleCache::instance().name(type); }
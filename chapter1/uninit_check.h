@@ -0,0 +1,189 @@
+/*
+===============================================================================
+TITLE: Uninitialized-read instrumentation (-DUNINIT_CHECK)
+TOPIC: Catch `int featureEnabled;` being read, on purpose instead of by luck
+
+    TRACKED_VAR(int, featureEnabled);            // int featureEnabled;
+    TRACKED_VAR_INIT(int, featureEnabled, 1);    // int featureEnabled = 1;
+    if (TRACKED_READ(featureEnabled)) { ... }    // featureEnabled
+
+WITHOUT -DUNINIT_CHECK the macros expand to exactly the plain code above,
+so the release binary is unchanged.
+
+WITH -DUNINIT_CHECK:
+- POISON  : a tracked variable starts filled with kPoisonByte (0xAA), and
+            the global operator new fills heap blocks with the same byte.
+            Untracked locals are poisoned by the compiler when built with
+            -ftrivial-auto-var-init=pattern (GCC 12+, clang), so garbage
+            is always the same recognizable value instead of "whatever
+            was on the stack" - 0xAAAAAAAA = -1431655766 for an int
+- SHADOW  : next to the value sits a one-byte tag, Uninitialized until the
+            first write. A read costs one byte compare that is predicted
+            not taken - near release speed, fine for canary builds
+            (benchmarks/uninit_bench.cpp: no measurable cost on a
+            processCriticalData-shaped function; a tight loop over many
+            Tracked values stops vectorizing, so track flags, not arrays)
+- EVENTS  : the first uninitialized read of each declaration becomes one
+            structured line in the attached Logger:
+                UNINIT_READ variable=featureEnabled function=processCriticalData
+                    declared=<line> read=<line> value=-1431655766
+            declared/read are the source lines of TRACKED_VAR and of the
+            first TRACKED_READ. Later reads only bump counters
+            (uninitReadCount()), so a hot loop cannot flood the log
+
+HEAP POISON: the replacement operator new/delete is only defined where
+UNINIT_CHECK_HEAP_POISON is defined before the include - do that in
+exactly ONE translation unit per program (the one with main), so any number
+of files can include this header. Do not combine it with alloc_counter.h.
+===============================================================================
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "logger.h"
+
+constexpr unsigned char kPoisonByte = 0xAA;
+
+#ifdef UNINIT_CHECK
+
+// One per TRACKED_VAR declaration, static storage: costs nothing per call
+struct UninitSite {
+    const char* variable;
+    const char* function;
+    int line;
+    mutable std::atomic<std::size_t> reads{0};   // Uninitialized reads seen here
+};
+
+class UninitMonitor {
+private:
+    static std::atomic<Logger*>& target() {
+        static std::atomic<Logger*> logger{nullptr};
+        return logger;
+    }
+
+    static std::atomic<std::size_t>& total() {
+        static std::atomic<std::size_t> count{0};
+        return count;
+    }
+
+public:
+    // Events go to this Logger (sync, async or binary backend) until detach()
+    static void attach(Logger& logger) { target().store(&logger, std::memory_order_release); }
+    static void detach() { target().store(nullptr, std::memory_order_release); }
+
+    static std::size_t readCount() { return total().load(std::memory_order_relaxed); }
+
+    // Slow path, only reached when a read actually hits an uninitialized value
+    static void report(const UninitSite& site, int readLine, long long value) {
+        total().fetch_add(1, std::memory_order_relaxed);
+        if (site.reads.fetch_add(1, std::memory_order_relaxed) != 0) return;
+        if (Logger* logger = target().load(std::memory_order_acquire)) {
+            static const LogFormat event("UNINIT_READ variable={} function={} declared={} read={} value={}");
+            logger->logf(event, site.variable, site.function, site.line, readLine, value);
+        }
+    }
+};
+
+inline std::size_t uninitReadCount() { return UninitMonitor::readCount(); }
+
+// A scalar plus its shadow tag
+template <typename T>
+class Tracked {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                  "Tracked<T> is meant for the scalars the compiler leaves uninitialized");
+
+private:
+    enum class Shadow : unsigned char { Uninitialized, Initialized };
+
+    T value;
+    Shadow shadow = Shadow::Uninitialized;
+    const UninitSite* site;
+
+    static long long asNumber(T raw) {
+        if constexpr (std::is_enum<T>::value) {
+            return static_cast<long long>(static_cast<typename std::underlying_type<T>::type>(raw));
+        } else {
+            return static_cast<long long>(raw);
+        }
+    }
+
+public:
+    explicit Tracked(const UninitSite& declaration) : site(&declaration) {
+        std::memset(static_cast<void*>(&value), kPoisonByte, sizeof(value));
+    }
+
+    Tracked(const UninitSite& declaration, T initial)
+        : value(initial), shadow(Shadow::Initialized), site(&declaration) {}
+
+    Tracked& operator=(T next) {
+        value = next;
+        shadow = Shadow::Initialized;
+        return *this;
+    }
+
+    T read(int line) const {
+        if (__builtin_expect(shadow != Shadow::Initialized, 0)) {
+            UninitMonitor::report(*site, line, asNumber(value));
+        }
+        return value;
+    }
+
+    // Plain reads still get checked, only without the read line
+    operator T() const { return read(0); }
+};
+
+#define UNINIT_SITE_NAME_(name) uninitSite_##name##_
+
+#define TRACKED_VAR(type, name)                                                          \
+    static const UninitSite UNINIT_SITE_NAME_(name){#name, __func__, __LINE__};         \
+    Tracked<type> name{UNINIT_SITE_NAME_(name)}
+
+#define TRACKED_VAR_INIT(type, name, initial)                                            \
+    static const UninitSite UNINIT_SITE_NAME_(name){#name, __func__, __LINE__};         \
+    Tracked<type> name{UNINIT_SITE_NAME_(name), initial}
+
+#define TRACKED_READ(name) (name).read(__LINE__)
+
+#ifdef UNINIT_CHECK_HEAP_POISON
+// Fresh heap blocks hold the poison pattern instead of recycled data.
+// malloc/free underneath, for every form of new/delete that lands here. Not
+// inlined: GCC would otherwise see free() applied to what it assumes is
+// ::operator new memory (-Wmismatched-new-delete)
+[[gnu::noinline]] void* operator new(std::size_t size) {
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        std::memset(memory, kPoisonByte, size);
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void* operator new[](std::size_t size) { return ::operator new(size); }
+
+[[gnu::noinline]] void operator delete(void* memory) noexcept { std::free(memory); }
+[[gnu::noinline]] void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+[[gnu::noinline]] void operator delete[](void* memory) noexcept { std::free(memory); }
+[[gnu::noinline]] void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+#endif
+
+#else   // Instrumentation off: plain variables, plain reads
+
+struct UninitMonitor {
+    static void attach(Logger&) {}
+    static void detach() {}
+    static std::size_t readCount() { return 0; }
+};
+
+inline std::size_t uninitReadCount() { return 0; }
+
+#define TRACKED_VAR(type, name) type name
+#define TRACKED_VAR_INIT(type, name, initial) type name = initial
+#define TRACKED_READ(name) (name)
+
+#endif
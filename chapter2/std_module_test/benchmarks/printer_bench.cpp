@@ -0,0 +1,84 @@
+/*
+===============================================================================
+TITLE: Formatted line output throughput
+TOPIC: std::println vs printf vs iostream vs printer::println
+
+Every case writes the same line, "record <int> value <double> name <text>",
+once per operation. Results are in lines per second. stdout is /dev/null
+(or a file given on the command line) and the report goes to stderr.
+
+CASES:
+1. std::println("record {} value {:.3f} name {}")   - locks stdout per call
+2. std::printf("record %d value %.3f name %s\n")
+3. std::cout << ... << '\n'
+4. std::cout << ... << std::endl                      - flush per line
+5. printer::println (same format as 1)                - thread-local buffer
+
+USAGE:
+    ./printer_bench                 # to /dev/null: formatting cost only
+    ./printer_bench lines.txt       # to a file: adds the write() calls
+===============================================================================
+*/
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <print>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../../../chapter1/benchmarks/bench.h"
+#include "../printer.h"
+
+void report(const BenchResult& result) {
+    std::fprintf(stderr, "%-32s %8.1f ns/line %14.0f lines/s\n", result.name.c_str(), result.nsPerOp,
+                 1e9 / result.nsPerOp);
+}
+
+int main(int argc, char** argv) {
+    const std::size_t iterations = 1000000;
+    const char* names[] = {"alpha", "bravo", "charlie", "delta"};
+    const double values[] = {3.14159, -2.5, 1234.5678, 0.001};
+
+    int target = argc > 1 ? ::open(argv[1], O_WRONLY | O_CREAT | O_TRUNC, 0644) : ::open("/dev/null", O_WRONLY);
+    if (target < 0) {
+        std::fprintf(stderr, "cannot open %s\n", argc > 1 ? argv[1] : "/dev/null");
+        return 1;
+    }
+    ::dup2(target, STDOUT_FILENO);
+
+    report(runBench("std::println", iterations, [&](std::size_t i) {
+        std::println("record {} value {:.3f} name {}", i, values[i & 3], names[i & 3]);
+    }));
+    std::fflush(stdout);
+    report(runBench("std::printf", iterations, [&](std::size_t i) {
+        std::printf("record %zu value %.3f name %s\n", i, values[i & 3], names[i & 3]);
+    }));
+    std::fflush(stdout);
+    std::cout << std::fixed << std::setprecision(3);
+    report(runBench("std::cout << '\\n'", iterations, [&](std::size_t i) {
+        std::cout << "record " << i << " value " << values[i & 3] << " name " << names[i & 3] << '\n';
+    }));
+    report(runBench("std::cout << std::endl", iterations / 10, [&](std::size_t i) {
+        std::cout << "record " << i << " value " << values[i & 3] << " name " << names[i & 3] << std::endl;
+    }));
+    report(runBench("printer::println", iterations, [&](std::size_t i) {
+        printer::println("record {} value {:.3f} name {}", i, values[i & 3], names[i & 3]);
+    }));
+    printer::flush();
+    return 0;
+}
+
+/*
+===============================================================================
+COMPILE AND RUN INSTRUCTIONS:
+
+clang++ -std=c++23 -O2 -DNDEBUG printer_bench.cpp -o printer_bench
+./printer_bench
+
+or with the CMake project (target printer_bench, header-based like test_print).
+Needs <print> and <format>: libc++ 17+ or libstdc++ 14+.
+===============================================================================
+*/
@@ -1,6 +1,7 @@
-#include <print>
+import std;
+import printer;   // printer.cppm: buffered, compile-time checked println
 
 int main() {
-  std::println("Hello, C++23 Modules!");
+  printer::println("Hello, C++23 Modules!");
   return 0;
 }
@@ -0,0 +1,17 @@
+// Module interface for printer.h, for targets built with import std;
+//
+//     import std;
+//     import printer;
+//     printer::println("Hello, {}!", "modules");
+module;
+
+#include <cstdio>   // stdout is a macro, and import std; exports no macros
+
+export module printer;
+
+import std;
+
+#define PRINTER_IN_MODULE
+export {
+#include "printer.h"
+}
@@ -0,0 +1,111 @@
+/*
+===============================================================================
+TITLE: Buffered std::print replacement
+TOPIC: std::format_to into a thread-local buffer, flushed in large writes
+
+    printer::println("Hello, C++23!");                  // like std::println
+    printer::print("{} + {} = {}\n", 1, 2, 1 + 2);      // like std::print
+    printer::flush();                                   // before reading input
+
+WHY:
+- std::println locks stdout and writes through it on every call; with a
+  terminal or pipe on the other side that is often one write() per line
+- printer::print formats straight into the calling thread's own buffer
+  (no lock, no stdio) and hands the buffer to stdout only when it is full
+
+FLUSH POLICY (one rule for every call):
+- The buffer is written out when it holds kFlushBytes or more, when the
+  thread exits (main thread: at exit() or return from main), and on an
+  explicit printer::flush()
+- Each flush is ONE fwrite of whole lines followed by fflush(stdout), so
+  lines of different threads never tear, and std::println / printf
+  output written after printer::flush() stays in order
+- Output still buffered when the process dies (abort, a crash, _exit) is
+  lost: call printer::flush() before anything that must be visible
+
+FORMAT STRINGS:
+- The first parameter is std::format_string<Args...>, exactly as in
+  std::print: a bad format string or a wrong argument is a COMPILE error
+
+USE:
+- #include "printer.h"                   (header-based targets: test_print)
+- import printer;  (after import std;)    (module targets: std_module_test,
+                                          through printer.cppm)
+
+benchmarks/printer_bench.cpp: lines per second against std::println,
+printf and iostream.
+===============================================================================
+*/
+
+#pragma once
+
+// printer.cppm sets PRINTER_IN_MODULE and provides the standard library
+// through import std; a header-based build includes what it uses
+#ifndef PRINTER_IN_MODULE
+#include <cstddef>
+#include <cstdio>
+#include <format>
+#include <iterator>
+#include <string>
+#include <utility>
+#endif
+
+namespace printer {
+
+inline constexpr std::size_t kFlushBytes = 64 * 1024;
+
+class ThreadBuffer {
+private:
+    std::string text;
+
+public:
+    ThreadBuffer() { text.reserve(kFlushBytes + kFlushBytes / 4); }
+
+    ThreadBuffer(const ThreadBuffer&) = delete;
+    ThreadBuffer& operator=(const ThreadBuffer&) = delete;
+
+    std::string& data() { return text; }
+
+    void flush() {
+        if (text.empty()) return;
+        std::fwrite(text.data(), 1, text.size(), stdout);
+        std::fflush(stdout);
+        text.clear();
+    }
+
+    void flushIfFull() {
+        if (text.size() >= kFlushBytes) flush();
+    }
+
+    ~ThreadBuffer() { flush(); }
+};
+
+inline ThreadBuffer& threadBuffer() {
+    thread_local ThreadBuffer buffer;
+    return buffer;
+}
+
+template <typename... Args>
+void print(std::format_string<Args...> format, Args&&... args) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::format_to(std::back_inserter(buffer.data()), format, std::forward<Args>(args)...);
+    buffer.flushIfFull();
+}
+
+template <typename... Args>
+void println(std::format_string<Args...> format, Args&&... args) {
+    ThreadBuffer& buffer = threadBuffer();
+    std::format_to(std::back_inserter(buffer.data()), format, std::forward<Args>(args)...);
+    buffer.data().push_back('\n');
+    buffer.flushIfFull();
+}
+
+inline void println() {
+    threadBuffer().data().push_back('\n');
+    threadBuffer().flushIfFull();
+}
+
+// Writes out what the CALLING thread has buffered
+inline void flush() { threadBuffer().flush(); }
+
+}  // namespace printer
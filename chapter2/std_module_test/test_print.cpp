@@ -1,6 +1,26 @@
 #include <print>
+#include <vector>
+
+// Same C++11 formatting layer the chapter1 print() overloads use
+#include "../../chapter1/fast_format.h"
+// Buffered std::println replacement (thread-local buffer, compile-time checked)
+#include "printer.h"
 
 int main() {
   std::println("Hello, C++23!");
+
+  // Both go to stdout through stdio, so the lines stay in order
+  std::vector<int> numbers = {1, -22, 333, 2147483647, -2147483647 - 1};
+  FormatBuffer out;
+  out.append("FormatBuffer:");
+  for (int number : numbers) out.append(' ').append(number);
+  out.append('\n').flush();
+
+  std::println("std::println: {} {} {} {} {}", numbers[0], numbers[1], numbers[2], numbers[3], numbers[4]);
+
+  // Same format string, buffered: flush before anything else writes to stdout
+  printer::println("printer::println: {} {} {} {} {}", numbers[0], numbers[1], numbers[2], numbers[3], numbers[4]);
+  // printer::println("{} {}", numbers[0]);   // Would not compile: two fields, one argument
+  printer::flush();
   return 0;
 }
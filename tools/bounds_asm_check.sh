@@ -0,0 +1,101 @@
+#!/usr/bin/env bash
+# =============================================================================
+# TITLE: Assembly check for the fixed-size HW1_3 overloads
+#
+# Compiles a few one-line callers of the T (&)[N] / std::array overloads in
+# chapter1/HW1_3_solution.cpp with -O2 -S and checks the hot path of each
+# (from its label to the first .cfi_endproc, so a .cold throw path that the
+# compiler split off is not counted):
+#
+#   constant index : foo_exception(table, 1, 2), *foo_optional(table, 1, 2)
+#                    -> no cmp/test, no conditional jump, no call: one load
+#   runtime index  : foo_exception / foo_optional with int[5], foo_exception
+#                    with std::array<int, 5>
+#                    -> exactly one cmp and one unsigned conditional jump
+#                       (ja / jae / jb / jbe)
+#
+# USAGE:
+#   tools/bounds_asm_check.sh              # CXX=c++ CXXFLAGS="-O2 -DNDEBUG"
+#   CXX=clang++ tools/bounds_asm_check.sh
+#
+# Exit 0 when every function passes, 1 on a failure, 77 (skipped) on
+# targets other than x86-64. chapter1/CMakeLists.txt runs it as a CTest.
+# =============================================================================
+
+set -u
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+CXX="${CXX:-c++}"
+CXXFLAGS="${CXXFLAGS:--O2 -DNDEBUG}"
+WORK="$(mktemp -d "${TMPDIR:-/tmp}/bounds_asm_check.XXXXXX")"
+trap 'rm -rf "$WORK"' EXIT
+
+if ! $CXX -dumpmachine | grep -q '^x86_64'; then
+    echo "skipped: the expected instructions are x86-64 ($($CXX -dumpmachine))"
+    exit 77
+fi
+
+cat > "$WORK/probe.cpp" <<PROBE
+#define HW1_3_NO_MAIN
+#include "$ROOT/chapter1/HW1_3_solution.cpp"
+
+int table[5];
+std::array<int, 5> arrayTable;
+
+extern "C" int constant_exception() { return foo_exception(table, 1, 2); }
+extern "C" int constant_optional() { return *foo_optional(table, 1, 2); }
+extern "C" int runtime_exception(int base, int off) { return foo_exception(table, base, off); }
+extern "C" int runtime_optional(int base, int off) { return foo_optional(table, base, off).value_or(-1); }
+extern "C" int runtime_array(int base, int off) { return foo_exception(arrayTable, base, off); }
+PROBE
+
+# shellcheck disable=SC2086
+if ! $CXX -std=c++23 $CXXFLAGS -S "$WORK/probe.cpp" -o "$WORK/probe.s"; then
+    echo "cannot compile the probe" >&2
+    exit 1
+fi
+
+# Instructions of the hot path of one function, one mnemonic per line
+hot_path() {
+    awk -v name="$1" '
+        $0 ~ "^_?" name ":" { inside = 1; next }
+        inside && /\.cfi_endproc/ { exit }
+        inside && /^\t[a-z]/ { print $1 }
+    ' "$WORK/probe.s"
+}
+
+count() { grep -c -E "$1" || true; }
+
+failures=0
+check() {
+    local name="$1" compares="$2" jumps="$3" calls="$4" code
+    code="$(hot_path "$name")"
+    if [ -z "$code" ]; then
+        echo "FAIL $name: not found in the assembly"
+        failures=$((failures + 1))
+        return
+    fi
+    local cmp jcc unsigned call
+    cmp=$(echo "$code" | count '^(cmp|test)')
+    jcc=$(echo "$code" | count '^j([^m]|m[^p])')
+    unsigned=$(echo "$code" | count '^j(a|ae|b|be)$')
+    call=$(echo "$code" | count '^call')
+    if [ "$cmp" -eq "$compares" ] && [ "$jcc" -eq "$jumps" ] && [ "$unsigned" -eq "$jumps" ] &&
+       { [ "$calls" = any ] || [ "$call" -eq "$calls" ]; }; then
+        echo "ok   $name: $cmp compare, $jcc conditional jump, $(echo "$code" | wc -l | tr -d ' ') instructions"
+    else
+        echo "FAIL $name: $cmp compares, $jcc conditional jumps ($unsigned unsigned), $call calls:"
+        echo "$code" | sed 's/^/       /'
+        failures=$((failures + 1))
+    fi
+}
+
+echo "$CXX -std=c++23 $CXXFLAGS"
+check constant_exception 0 0 0
+check constant_optional 0 0 0
+# The throw path may stay inline (clang) or move to a .cold part (GCC)
+check runtime_exception 1 1 any
+check runtime_optional 1 1 0
+check runtime_array 1 1 any
+
+[ "$failures" -eq 0 ]
@@ -0,0 +1,191 @@
+#!/usr/bin/env bash
+# =============================================================================
+# TITLE: Compile-time benchmark - headers vs precompiled header vs import std
+#
+# Compiles every program of every chapter (chapter*/*.cpp and
+# chapter*/benchmarks/*.cpp) to an object file in three configurations:
+#
+#   headers : the sources as they are (#include <...>)
+#   pch     : the same sources, with every standard header they use
+#             precompiled once into one PCH and force-included
+#   module  : a copy of the sources where the standard C++ headers are
+#             replaced by `import std;`; headers that only exist for their
+#             macros (<cassert>, <climits>, <cstdio>, ...) stay as #include,
+#             because modules do not export macros
+#
+# Reported per file: best wall-clock compile time of REPEAT runs and object
+# size. Per configuration: totals, plus the one-time cost of building the
+# PCH or the std module, which a real build pays once. Named modules of the
+# chapters (chapter*/*/*.cppm, e.g. printer) are built once after std.
+#
+# USAGE:
+#   tools/compile_bench.sh                  # CXX=c++ REPEAT=3 CXXFLAGS="-O2"
+#   CXX=clang++ REPEAT=5 tools/compile_bench.sh
+#
+# import std needs clang 18+ with libc++ or GCC 15+; with other compilers
+# the module configuration is reported as skipped. With clang the module
+# configuration links against libc++, the library that ships std.cppm.
+# =============================================================================
+
+set -u
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+CXX="${CXX:-c++}"
+REPEAT="${REPEAT:-3}"
+CXXFLAGS="${CXXFLAGS:--O2}"
+STD="-std=c++23"
+WORK="$(mktemp -d "${TMPDIR:-/tmp}/compile_bench.XXXXXX")"
+trap 'rm -rf "$WORK"' EXIT
+
+# Headers that a module import cannot replace: they are used for macros
+MACRO_HEADERS="cassert|cctype|cerrno|cfloat|cinttypes|climits|cmath|csignal|cstddef|cstdint|cstdio|cstdlib|cstring|ctime"
+
+cd "$ROOT" || exit 1
+SOURCES=$(ls chapter*/*.cpp chapter*/benchmarks/*.cpp chapter*/*/*.cpp 2>/dev/null | sort -u)
+
+now_ns() { date +%s%N; }
+
+# Best of REPEAT runs of a compile command; prints milliseconds, or "failed"
+time_compile() {
+    local best="" start elapsed
+    for _ in $(seq "$REPEAT"); do
+        start=$(now_ns)
+        if ! "$@" >/dev/null 2>&1; then
+            echo failed
+            return
+        fi
+        elapsed=$(( ($(now_ns) - start) / 1000000 ))
+        if [ -z "$best" ] || [ "$elapsed" -lt "$best" ]; then best=$elapsed; fi
+    done
+    echo "$best"
+}
+
+object_size() { stat -c %s "$1" 2>/dev/null || stat -f %z "$1"; }
+
+is_clang() { "$CXX" --version 2>/dev/null | grep -qi clang; }
+
+# -----------------------------------------------------------------------------
+# Source trees: module/ is a rewritten copy, headers/ and pch/ use the originals
+# -----------------------------------------------------------------------------
+
+mkdir -p "$WORK/module" "$WORK/obj/headers" "$WORK/obj/pch" "$WORK/obj/module"
+cp -R chapter* "$WORK/module/"
+for file in $(cd "$WORK/module" && find . -name '*.cpp' -o -name '*.h'); do
+    path="$WORK/module/$file"
+    grep -q '^import std;' "$path" && continue
+    sed -E -i.bak "/^#include <($MACRO_HEADERS)>/b; /^#include <[a-z_]+>/d" "$path"
+    case "$file" in
+        *.cpp) sed -i.bak '1i\
+import std;
+' "$path" ;;
+    esac
+    rm -f "$path.bak"
+done
+
+# -----------------------------------------------------------------------------
+# One-time artifacts
+# -----------------------------------------------------------------------------
+
+# The PCH contains every standard header any program includes (those this library has)
+grep -h '^#include <' $SOURCES chapter*/*.h 2>/dev/null | sed 's/^#include //' | sort -u |
+    while read -r header; do
+        printf '#if __has_include(%s)\n#include %s\n#endif\n' "$header" "$header"
+    done > "$WORK/std_pch.h"
+if is_clang; then
+    PCH_BUILD=(-x c++-header "$WORK/std_pch.h" -o "$WORK/std_pch.pch")
+    PCH_USE=(-include-pch "$WORK/std_pch.pch")
+else
+    PCH_BUILD=(-x c++-header "$WORK/std_pch.h" -o "$WORK/std_pch.h.gch")
+    PCH_USE=(-include "$WORK/std_pch.h" -Winvalid-pch)
+fi
+PCH_MS=$(time_compile "$CXX" $STD $CXXFLAGS "${PCH_BUILD[@]}")
+
+# The std module source is listed in the standard library's modules manifest
+MODULE_MS=skipped
+MODULE_USE=()
+if is_clang; then
+    MANIFEST=$("$CXX" -stdlib=libc++ -print-file-name=libc++.modules.json 2>/dev/null)
+else
+    MANIFEST=$("$CXX" -print-file-name=libstdc++.modules.json 2>/dev/null)
+fi
+STD_SOURCE=$(sed -n 's/.*"source-path": *"\([^"]*\/std\.\(cppm\|cc\)\)".*/\1/p' "$MANIFEST" 2>/dev/null | head -n 1)
+if [ -n "$STD_SOURCE" ] && [ -f "$(dirname "$MANIFEST")/$STD_SOURCE" ]; then
+    STD_SOURCE="$(dirname "$MANIFEST")/$STD_SOURCE"
+    if is_clang; then
+        MODULE_MS=$(time_compile "$CXX" $STD $CXXFLAGS -stdlib=libc++ -Wno-reserved-module-identifier \
+                    --precompile "$STD_SOURCE" -o "$WORK/std.pcm")
+        MODULE_USE=(-stdlib=libc++ -fmodule-file=std="$WORK/std.pcm")
+    else
+        # GCC writes the compiled interface to gcm.cache/std.gcm in the working directory
+        MODULE_MS=$( (cd "$WORK" && time_compile "$CXX" $STD $CXXFLAGS -fmodules -c "$STD_SOURCE" -o std.o) )
+        MODULE_USE=(-fmodules)
+    fi
+fi
+[ "$MODULE_MS" = failed ] && MODULE_USE=()
+
+# Named modules of the chapters (e.g. printer.cppm), built once on top of std
+if [ ${#MODULE_USE[@]} -gt 0 ]; then
+    for interface in $(cd "$WORK/module" && ls chapter*/*/*.cppm 2>/dev/null); do
+        name=$(sed -n 's/^export module \([A-Za-z_.]*\);/\1/p' "$WORK/module/$interface")
+        if is_clang; then
+            (cd "$WORK" && "$CXX" $STD $CXXFLAGS "${MODULE_USE[@]}" --precompile "module/$interface" \
+                -o "$name.pcm") >/dev/null 2>&1 && MODULE_USE+=(-fmodule-file="$name=$WORK/$name.pcm")
+        else
+            (cd "$WORK" && "$CXX" $STD $CXXFLAGS "${MODULE_USE[@]}" -x c++ -c "module/$interface" \
+                -o "$name.o") >/dev/null 2>&1
+        fi
+    done
+fi
+
+# -----------------------------------------------------------------------------
+# Per-program compile times
+# -----------------------------------------------------------------------------
+
+declare -A TOTAL_MS TOTAL_BYTES FAILED
+for config in headers pch module; do TOTAL_MS[$config]=0; TOTAL_BYTES[$config]=0; FAILED[$config]=0; done
+
+record() {   # config source ms object
+    local size=-
+    if [ "$3" = failed ] || [ "$3" = skipped ]; then
+        [ "$3" = failed ] && FAILED[$1]=$(( FAILED[$1] + 1 ))
+    else
+        size=$(object_size "$4")
+        TOTAL_MS[$1]=$(( TOTAL_MS[$1] + $3 ))
+        TOTAL_BYTES[$1]=$(( TOTAL_BYTES[$1] + size ))
+    fi
+    printf "%-8s %-48s %10s %12s\n" "$1" "$2" "$3" "$size"
+}
+
+echo "compiler: $($CXX --version | head -n 1)   flags: $STD $CXXFLAGS   best of $REPEAT"
+printf "%-8s %-48s %10s %12s\n" config source ms "object B"
+for source in $SOURCES; do
+    object="$(echo "$source" | tr '/' '_').o"
+    if grep -q '^import std;' "$source"; then      # Already module-only
+        record headers "$source" skipped ""
+        record pch "$source" skipped ""
+        ms=$( (cd "$WORK" && time_compile "$CXX" $STD $CXXFLAGS "${MODULE_USE[@]}" \
+              -c "module/$source" -o "obj/module/$object") )
+        [ ${#MODULE_USE[@]} -eq 0 ] && ms=skipped
+        record module "$source" "$ms" "$WORK/obj/module/$object"
+        continue
+    fi
+    ms=$(time_compile "$CXX" $STD $CXXFLAGS -c "$source" -o "$WORK/obj/headers/$object")
+    record headers "$source" "$ms" "$WORK/obj/headers/$object"
+
+    ms=$(time_compile "$CXX" $STD $CXXFLAGS "${PCH_USE[@]}" -c "$source" -o "$WORK/obj/pch/$object")
+    record pch "$source" "$ms" "$WORK/obj/pch/$object"
+
+    if [ ${#MODULE_USE[@]} -eq 0 ]; then
+        record module "$source" skipped ""
+    else
+        ms=$( (cd "$WORK" && time_compile "$CXX" $STD $CXXFLAGS "${MODULE_USE[@]}" \
+              -c "module/$source" -o "obj/module/$object") )
+        record module "$source" "$ms" "$WORK/obj/module/$object"
+    fi
+done
+
+echo
+printf "%-8s %14s %12s %14s %8s\n" config "one-time ms" "total ms" "total obj B" failed
+printf "%-8s %14s %12s %14s %8s\n" headers - "${TOTAL_MS[headers]}" "${TOTAL_BYTES[headers]}" "${FAILED[headers]}"
+printf "%-8s %14s %12s %14s %8s\n" pch "$PCH_MS" "${TOTAL_MS[pch]}" "${TOTAL_BYTES[pch]}" "${FAILED[pch]}"
+printf "%-8s %14s %12s %14s %8s\n" module "$MODULE_MS" "${TOTAL_MS[module]}" "${TOTAL_BYTES[module]}" "${FAILED[module]}"
@@ -0,0 +1,174 @@
+#!/usr/bin/env bash
+# =============================================================================
+# TITLE: Differential debug-vs-release runner
+#
+# Builds one program at several optimization levels, runs every variant many
+# times in parallel and compares what the variants did:
+#
+#   1. BUILD  : one binary per level in LEVELS; -O0 gets -g, the others
+#               -DNDEBUG (the debug_bug / release_bug pair, and more)
+#   2. RUN    : RUNS runs per variant spread over JOBS processes, each in its
+#               own directory so debug_log.txt files never collide
+#   3. DIFF   : the log of every run is hashed; per variant the most common
+#               log is diffed line by line against the first variant's.
+#               Runs of one variant that disagree with each other are flagged
+#               as nondeterministic. Programs without a log file are compared
+#               on stdout instead
+#   4. BRANCH : lines matching PATTERN (default "IF CONDITION") that differ
+#               are listed separately - they are the divergent branches.
+#               Per variant it also counts in how many runs each such line
+#               appeared, which exposes branches that flip from run to run
+#   5. TIME   : wall time of each run, as min / median / p90 / max per variant
+#
+# USAGE:
+#   tools/diff_runner.sh chapter1/debug_vs_release_bug.cpp
+#   RUNS=50 LEVELS="-O0 -O2" tools/diff_runner.sh chapter1/HW1_3_solution.cpp
+#   tools/diff_runner.sh chapter1/debug_vs_release_bug.cpp -DASYNC_LOG -pthread
+#
+# Arguments after the source file are passed to the compiler.
+# Environment: CXX (c++), STD (-std=c++23), LEVELS ("-O0 -O1 -O2 -O3"),
+# RUNS (20), JOBS (cores), LOG (debug_log.txt), PATTERN ("IF CONDITION"),
+# KEEP=1 keeps the work directory.
+#
+# Exit status: 0 when all variants agree, 1 when any log differs, 2 on a
+# build failure.
+# =============================================================================
+
+set -u
+
+# Internal: one run of one variant (called in parallel through xargs)
+if [ "${1:-}" = "--run-one" ]; then
+    dir="$2"
+    binary="$3"
+    mkdir -p "$dir" && cd "$dir" || exit 1
+    start=$(date +%s%N)
+    "$binary" > stdout.txt 2> stderr.txt
+    status=$?
+    echo "$(( ($(date +%s%N) - start) / 1000 )) $status" > result.txt
+    exit 0
+fi
+
+if [ $# -lt 1 ] || [ ! -f "$1" ]; then
+    sed -n '2,35s/^# \{0,1\}//p' "$0"
+    exit 2
+fi
+
+SOURCE="$(cd "$(dirname "$1")" && pwd)/$(basename "$1")"
+shift
+EXTRA_FLAGS=("$@")
+CXX="${CXX:-c++}"
+STD="${STD:--std=c++23}"
+LEVELS="${LEVELS:--O0 -O1 -O2 -O3}"
+RUNS="${RUNS:-20}"
+JOBS="${JOBS:-$(nproc 2>/dev/null || sysctl -n hw.ncpu 2>/dev/null || echo 4)}"
+LOG="${LOG:-debug_log.txt}"
+PATTERN="${PATTERN:-IF CONDITION}"
+SELF="$(cd "$(dirname "$0")" && pwd)/$(basename "$0")"
+WORK="$(mktemp -d "${TMPDIR:-/tmp}/diff_runner.XXXXXX")"
+[ "${KEEP:-0}" = 1 ] || trap 'rm -rf "$WORK"' EXIT
+
+# md5sum on Linux, md5 on macOS, POSIX cksum as the last resort
+if command -v md5sum >/dev/null 2>&1; then
+    hash_file() { md5sum "$1" | cut -d' ' -f1; }
+elif command -v md5 >/dev/null 2>&1; then
+    hash_file() { md5 -q "$1"; }
+else
+    hash_file() { cksum < "$1" | tr ' ' '-'; }
+fi
+
+# -----------------------------------------------------------------------------
+# 1. Build
+# -----------------------------------------------------------------------------
+
+VARIANTS=()
+for level in $LEVELS; do
+    name="${level#-}"
+    if [ "$level" = "-O0" ]; then flags=(-g -O0); else flags=("$level" -DNDEBUG); fi
+    mkdir -p "$WORK/$name"
+    if ! "$CXX" $STD "${flags[@]}" "${EXTRA_FLAGS[@]}" "$SOURCE" -o "$WORK/$name/program" 2> "$WORK/$name/build.txt"; then
+        echo "build failed for $level:"
+        cat "$WORK/$name/build.txt"
+        exit 2
+    fi
+    VARIANTS+=("$name")
+done
+echo "program: $SOURCE"
+echo "variants: ${VARIANTS[*]}   runs: $RUNS each   jobs: $JOBS   compiler: $($CXX --version | head -n 1)"
+
+# -----------------------------------------------------------------------------
+# 2. Run, interleaving variants so they share the machine equally
+# -----------------------------------------------------------------------------
+
+for run in $(seq "$RUNS"); do
+    for name in "${VARIANTS[@]}"; do
+        printf '%s\0%s\0%s\0' --run-one "$WORK/$name/run$run" "$WORK/$name/program"
+    done
+done | xargs -0 -n 3 -P "$JOBS" "$SELF"
+
+# -----------------------------------------------------------------------------
+# 3-5. Compare and report
+# -----------------------------------------------------------------------------
+
+# The compared stream of one run: the log file if the program wrote one
+stream_of() {
+    if [ -f "$1/$LOG" ]; then echo "$1/$LOG"; else echo "$1/stdout.txt"; fi
+}
+
+DIVERGED=0
+REFERENCE=""
+for name in "${VARIANTS[@]}"; do
+    # Most common output of this variant represents it
+    for run in $(seq "$RUNS"); do
+        echo "$(hash_file "$(stream_of "$WORK/$name/run$run")") $run"
+    done > "$WORK/$name/hashes.txt"
+    distinct=$(cut -d' ' -f1 "$WORK/$name/hashes.txt" | sort -u | wc -l | tr -d ' ')
+    common=$(cut -d' ' -f1 "$WORK/$name/hashes.txt" | sort | uniq -c | sort -rn | head -n 1 | awk '{print $2}')
+    representative=$(awk -v h="$common" '$1 == h {print $2; exit}' "$WORK/$name/hashes.txt")
+    stream="$(stream_of "$WORK/$name/run$representative")"
+    [ -z "$REFERENCE" ] && REFERENCE="$stream" && REFERENCE_NAME="$name"
+
+    echo
+    echo "=== $name: $(basename "$stream") ==="
+    if [ "$distinct" -gt 1 ]; then
+        echo "NONDETERMINISTIC: $distinct different outputs across $RUNS runs"
+        DIVERGED=1
+    fi
+    # How often each branch line was taken across all runs of this variant
+    for run in $(seq "$RUNS"); do
+        grep -hE "$PATTERN" "$(stream_of "$WORK/$name/run$run")" | sort -u
+    done | sort | uniq -c | awk -v runs="$RUNS" '{ count = $1; $1 = ""; printf "branch %3d/%d:%s\n", count, runs, $0 }'
+    exits=$(awk '{print $2}' "$WORK/$name"/run*/result.txt | sort | uniq -c | awk '{printf "%s x%s  ", $2, $1}')
+    echo "exit codes: $exits"
+
+    # Timing distribution in milliseconds
+    awk '{print $1}' "$WORK/$name"/run*/result.txt | sort -n | awk '
+        { t[NR] = $1 / 1000.0; sum += t[NR] }
+        END {
+            p50 = t[int((NR + 1) / 2)]; p90 = t[int(NR * 0.9 + 0.999)]
+            printf "time ms: min %.2f  median %.2f  p90 %.2f  max %.2f  mean %.2f\n", t[1], p50, p90, t[NR], sum / NR
+        }'
+
+    if [ "$stream" != "$REFERENCE" ]; then
+        if cmp -s "$REFERENCE" "$stream"; then
+            echo "same output as $REFERENCE_NAME"
+        else
+            DIVERGED=1
+            echo "DIFFERS from $REFERENCE_NAME:"
+            diff -u --label "$REFERENCE_NAME" --label "$name" "$REFERENCE" "$stream" | sed -n '3,$p' | sed 's/^/    /'
+            branches=$(diff "$REFERENCE" "$stream" | grep -E "^[<>].*$PATTERN" || true)
+            if [ -n "$branches" ]; then
+                echo "DIVERGENT BRANCHES ($PATTERN):"
+                echo "$branches" | sed -e "s/^</    $REFERENCE_NAME:/" -e "s/^>/    $name:/"
+            fi
+        fi
+    fi
+done
+
+echo
+if [ "$DIVERGED" = 1 ]; then
+    echo "RESULT: variants disagree"
+else
+    echo "RESULT: all variants agree"
+fi
+[ "${KEEP:-0}" = 1 ] && echo "work directory kept: $WORK"
+exit "$DIVERGED"
@@ -0,0 +1,62 @@
+#!/usr/bin/env bash
+# =============================================================================
+# TITLE: Round trip of the binary log through log_decode
+#
+# Builds a probe that sends the same LOG_FMT calls to a text Logger
+# (debug_log.txt) and to a binary Logger (debug_log.bin), decodes the binary
+# file with chapter1/log_decode.cpp and requires both texts to be identical.
+# The calls cover matching formats, more "{}" than arguments, more
+# arguments than "{}", and plain log(text).
+#
+# USAGE:
+#   tools/log_decode_check.sh              # CXX=c++ CXXFLAGS="-O2"
+#   CXX=clang++ tools/log_decode_check.sh
+#
+# Exit 0 when the decoded log matches, 1 otherwise.
+# chapter1/CMakeLists.txt runs it as a CTest.
+# =============================================================================
+
+set -u
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+CXX="${CXX:-c++}"
+CXXFLAGS="${CXXFLAGS:--O2}"
+WORK="$(mktemp -d "${TMPDIR:-/tmp}/log_decode_check.XXXXXX")"
+trap 'rm -rf "$WORK"' EXIT
+
+cat > "$WORK/probe.cpp" <<PROBE
+#include "$ROOT/chapter1/logger.h"
+
+template <typename L>
+void logAll(L& logger) {
+    LOG_FMT(logger, "value {} of {}", 3, std::string("five"));
+    LOG_FMT(logger, "a {} b {} c", 1);
+    LOG_FMT(logger, "only {} here", -7, 2.5, "extra");
+    LOG_FMT(logger, "no fields {}");
+    LOG_FMT(logger, "{}{} tail", 'x');
+    logger.log("plain text with {} inside");
+}
+
+int main() {
+    Logger text;
+    Logger binary{BinaryLogConfig{}};
+    logAll(text);
+    logAll(binary);
+    return 0;
+}
+PROBE
+
+cd "$WORK" || exit 1
+# shellcheck disable=SC2086
+if ! $CXX -std=c++17 $CXXFLAGS probe.cpp -o probe ||
+   ! $CXX -std=c++17 $CXXFLAGS "$ROOT/chapter1/log_decode.cpp" -o log_decode; then
+    echo "cannot build the probe or log_decode" >&2
+    exit 1
+fi
+
+./probe > /dev/null && ./log_decode debug_log.bin decoded.txt
+if ! diff -u debug_log.txt decoded.txt; then
+    echo "FAIL: log_decode output differs from the text Logger"
+    exit 1
+fi
+echo "OK: decoded binary log matches the text log ($(wc -l < decoded.txt | tr -d ' ') lines)"
@@ -0,0 +1,77 @@
+#!/usr/bin/env bash
+# =============================================================================
+# TITLE: Startup latency and binary size - normal vs lean build
+#
+# Builds the small demo programs twice and compares them:
+#
+#   normal : the sources as they are (<iostream>, std::cout)
+#   lean   : -DLEAN_OUTPUT (lean_out.h instead of <iostream>, stdio-based
+#            Logger sinks), -ffunction-sections -fdata-sections and
+#            --gc-sections, so unused code and data are not linked
+#   static : lean, linked with -static (skipped when the toolchain has no
+#            static libstdc++/libc)
+#
+# Every binary is then launched RUNS times by chapter1/benchmarks/
+# startup_bench.cpp: file size and exec-to-exit latency (min / median / p90).
+# The programs run in a scratch directory, so their debug_log.txt files do
+# not land in the tree.
+#
+# USAGE:
+#   tools/startup_bench.sh                    # CXX=c++ RUNS=200 CXXFLAGS="-O2"
+#   RUNS=1000 STATIC=0 tools/startup_bench.sh
+#
+# The same modes in CMake: -DCHAPTER1_LEAN=ON and -DCHAPTER1_STATIC=ON.
+# =============================================================================
+
+set -u
+
+ROOT="$(cd "$(dirname "$0")/.." && pwd)"
+CXX="${CXX:-c++}"
+RUNS="${RUNS:-200}"
+STATIC="${STATIC:-1}"
+CXXFLAGS="${CXXFLAGS:--O2}"
+STD="-std=c++23"
+LEAN_FLAGS="-DLEAN_OUTPUT -ffunction-sections -fdata-sections -Wl,--gc-sections"
+[ "$(uname)" = Darwin ] && LEAN_FLAGS="-DLEAN_OUTPUT -ffunction-sections -fdata-sections -Wl,-dead_strip"
+WORK="$(mktemp -d "${TMPDIR:-/tmp}/startup_bench.XXXXXX")"
+trap 'rm -rf "$WORK"' EXIT
+
+PROGRAMS="chapter1/HW1_1_solution.cpp chapter1/my.cpp chapter1/overload_test.cpp chapter1/debug_vs_release_bug.cpp
+chapter2/std_module_test/test_print.cpp"
+
+cd "$ROOT" || exit 1
+if ! $CXX -std=c++17 -O2 chapter1/benchmarks/startup_bench.cpp -o "$WORK/startup_bench"; then
+    echo "cannot build startup_bench" >&2
+    exit 1
+fi
+
+# build <source> <output> <flags...>; a failed build is reported and skipped
+build() {
+    local source="$1" output="$2"
+    shift 2
+    # shellcheck disable=SC2086
+    if $CXX $STD $CXXFLAGS "$@" "$source" -o "$output" -pthread 2>"$output.log"; then
+        echo "$output"
+    else
+        echo "  skipped: $output ($(head -n 1 "$output.log"))" >&2
+    fi
+}
+
+BINARIES=""
+for source in $PROGRAMS; do
+    name="$(basename "$source" .cpp)"
+    # shellcheck disable=SC2086
+    BINARIES="$BINARIES $(build "$source" "$WORK/${name}_normal")"
+    # shellcheck disable=SC2086
+    BINARIES="$BINARIES $(build "$source" "$WORK/${name}_lean" $LEAN_FLAGS)"
+    if [ "$STATIC" = 1 ]; then
+        # shellcheck disable=SC2086
+        BINARIES="$BINARIES $(build "$source" "$WORK/${name}_static" $LEAN_FLAGS -static)"
+    fi
+done
+
+echo "$CXX $STD $CXXFLAGS, $RUNS runs per binary (stdout to /dev/null)"
+echo
+cd "$WORK" || exit 1
+# shellcheck disable=SC2086
+./startup_bench --runs "$RUNS" $(for binary in $BINARIES; do basename "$binary"; done | sed 's|^|./|')